@@ -0,0 +1,266 @@
+// FastNoiseBenchmarkStandalone.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+
+// Standalone build of the FastNoise.Benchmark sweep, without the engine, used to measure Benchmarks/Baseline.csv.
+// It runs the same cases, grid sizes, repetitions and thread counts as FFastNoiseBenchmark::Run(...) and prints the same CSV as FFastNoiseBenchmark::ToCSV(...).
+// From the plugin source directory:
+//
+//	g++ -O2 -std=c++14 -pthread -DFASTNOISE_STANDALONE_BENCHMARK -I Benchmarks/Standalone -I . Benchmarks/FastNoiseBenchmarkStandalone.cpp FastNoise.cpp -o FastNoiseBenchmark
+//	./FastNoiseBenchmark [gridSize = 256] [maxThreads = hardware threads] > Benchmarks/Baseline.csv
+//
+// Benchmarks/Standalone/CoreMinimal.h stands in for the engine header included by FastNoise.h.
+// The define keeps this file empty when the engine compiles the module.
+
+#ifdef FASTNOISE_STANDALONE_BENCHMARK
+
+#include "FastNoise.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace FastNoiseBenchmark
+{
+	// Same as FFastNoiseBenchmark::NumRepetitions
+	static const int NumRepetitions = 3;
+
+	static const char* NoiseTypeNames[] = { "Value", "ValueFractal", "Perlin", "PerlinFractal", "Simplex", "SimplexFractal", "Cellular", "WhiteNoise", "Cubic", "CubicFractal" };
+	static const char* FractalTypeNames[] = { "FBM", "Billow", "RigidMulti" };
+	static const char* DistanceFunctionNames[] = { "Euclidean", "Manhattan", "Natural" };
+	static const char* ReturnTypeNames[] = { "CellValue", "NoiseLookup", "Distance", "Distance2", "Distance2Add", "Distance2Sub", "Distance2Mul", "Distance2Div" };
+
+	struct FCase
+	{
+		std::string name;
+		FastNoise noise;
+	};
+
+	/** Generates one grid the way the given path does, returns a checksum so the work can't be optimized away */
+	static float Generate(const FastNoise& noise, const bool bFillNoiseSet, const int dimensions, const int size, std::vector<float>& buffer)
+	{
+		float checksum = 0.0f;
+
+		if (dimensions == 2 && bFillNoiseSet)
+		{
+			noise.FillNoiseSet2D(buffer.data(), 0, 0, size, size);
+			checksum = buffer.back();
+		}
+		else if (dimensions == 3 && bFillNoiseSet)
+		{
+			noise.FillNoiseSet3D(buffer.data(), 0, 0, 0, size, size, size);
+			checksum = buffer.back();
+		}
+		else if (dimensions == 2)
+		{
+			for (int y = 0; y < size; y++)
+				for (int x = 0; x < size; x++)
+					checksum += noise.GetNoise(x, y);
+		}
+		else if (dimensions == 3)
+		{
+			for (int z = 0; z < size; z++)
+				for (int y = 0; y < size; y++)
+					for (int x = 0; x < size; x++)
+						checksum += noise.GetNoise(x, y, z);
+		}
+		else
+		{
+			// FastNoise only has 4D Simplex and White Noise, sampled on a gridSize^2 slice moving along z and w
+			const bool bWhiteNoise = noise.GetNoiseType() == FastNoise::WhiteNoise;
+
+			for (int y = 0; y < size; y++)
+				for (int x = 0; x < size; x++)
+					checksum += bWhiteNoise ? noise.GetWhiteNoise(x, y, x + y, x - y) : noise.GetSimplex(x, y, x + y, x - y);
+		}
+
+		return checksum;
+	}
+
+	/** Returns the seconds taken to generate the grid on each of numThreads concurrent threads, the fastest of NumRepetitions runs */
+	static double Time(const FastNoise& noise, const bool bFillNoiseSet, const int dimensions, const int size, const int numThreads, float& checksum)
+	{
+		const int numSamples = dimensions == 3 ? size * size * size : size * size;
+		std::vector<std::vector<float>> buffers(numThreads, std::vector<float>(numSamples));
+		std::vector<float> checksums(numThreads, 0.0f);
+
+		// Warm up caches before timing
+		checksum += Generate(noise, bFillNoiseSet, dimensions, size, buffers[0]);
+
+		double seconds = 1e30;
+
+		for (int repetition = 0; repetition < NumRepetitions; repetition++)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			if (numThreads == 1)
+			{
+				checksums[0] = Generate(noise, bFillNoiseSet, dimensions, size, buffers[0]);
+			}
+			else
+			{
+				std::vector<std::thread> threads;
+
+				for (int thread = 0; thread < numThreads; thread++)
+				{
+					threads.emplace_back([&, thread]() { checksums[thread] = Generate(noise, bFillNoiseSet, dimensions, size, buffers[thread]); });
+				}
+
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+			}
+
+			seconds = std::min(seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+			for (const float threadChecksum : checksums)
+			{
+				checksum += threadChecksum;
+			}
+		}
+
+		return seconds;
+	}
+
+	static std::vector<FCase> MakeCases()
+	{
+		std::vector<FCase> cases;
+
+		for (int noiseType = 0; noiseType < int(sizeof(NoiseTypeNames) / sizeof(NoiseTypeNames[0])); noiseType++)
+		{
+			const bool bFractal = noiseType == FastNoise::ValueFractal || noiseType == FastNoise::PerlinFractal || noiseType == FastNoise::SimplexFractal || noiseType == FastNoise::CubicFractal;
+
+			if (noiseType == FastNoise::Cellular)
+			{
+				for (int distanceFunction = 0; distanceFunction < 3; distanceFunction++)
+				{
+					for (int returnType = 0; returnType < 8; returnType++)
+					{
+						FCase cellularCase;
+						cellularCase.name = std::string("Cellular") + ReturnTypeNames[returnType] + " " + DistanceFunctionNames[distanceFunction];
+						cellularCase.noise.SetNoiseType(FastNoise::Cellular);
+						cellularCase.noise.SetCellularDistanceFunction(FastNoise::CellularDistanceFunction(distanceFunction));
+						cellularCase.noise.SetCellularReturnType(FastNoise::CellularReturnType(returnType));
+						cases.push_back(cellularCase);
+					}
+				}
+			}
+			else
+			{
+				for (int fractalType = 0; fractalType < (bFractal ? 3 : 1); fractalType++)
+				{
+					FCase noiseCase;
+					noiseCase.name = bFractal ? std::string(NoiseTypeNames[noiseType]) + " " + FractalTypeNames[fractalType] : std::string(NoiseTypeNames[noiseType]);
+					noiseCase.noise.SetNoiseType(FastNoise::NoiseType(noiseType));
+					noiseCase.noise.SetFractalType(FastNoise::FractalType(fractalType));
+					cases.push_back(noiseCase);
+				}
+			}
+		}
+
+		// Every case again with the integer hash index mode, White Noise doesn't index the tables in either mode
+		const size_t numTableCases = cases.size();
+		for (size_t i = 0; i < numTableCases; i++)
+		{
+			if (cases[i].noise.GetNoiseType() != FastNoise::WhiteNoise)
+			{
+				FCase hashCase = cases[i];
+				hashCase.name += " IntegerHash";
+				hashCase.noise.SetIndexMode(FastNoise::IntegerHash);
+				cases.push_back(hashCase);
+			}
+		}
+
+		return cases;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace FastNoiseBenchmark;
+
+	const int gridSize = argc > 1 ? std::max(1, atoi(argv[1])) : 256;
+	const int maxThreads = argc > 2 ? atoi(argv[2]) : 0;
+	const int threadLimit = maxThreads > 0 ? maxThreads : std::max(1, int(std::thread::hardware_concurrency()));
+
+	// Lookup for the NoiseLookup cellular cases, kept alive for the whole run
+	FastNoise lookup;
+	lookup.SetNoiseType(FastNoise::Simplex);
+
+	std::vector<FCase> cases = MakeCases();
+	float checksum = 0.0f;
+
+	printf("Case,Path,Dimensions,Threads,NsPerSample,SamplesPerSecondPerCore,Scaling\n");
+
+	for (FCase& noiseCase : cases)
+	{
+		noiseCase.noise.SetCellularNoiseLookup(&lookup);
+		const bool bHas4D = noiseCase.noise.GetNoiseType() == FastNoise::Simplex || noiseCase.noise.GetNoiseType() == FastNoise::WhiteNoise;
+
+		for (int dimensions = 2; dimensions <= 4; dimensions++)
+		{
+			if (dimensions == 4 && !bHas4D)
+			{
+				continue;
+			}
+
+			const int size = dimensions == 3 ? std::max(1, gridSize / 4) : gridSize;
+			const int numSamples = dimensions == 3 ? size * size * size : size * size;
+
+			for (int path = 0; path < (dimensions == 4 ? 1 : 2); path++)
+			{
+				double singleThreadSeconds = 0.0;
+
+				for (int threads = 1; threads <= threadLimit; threads *= 2)
+				{
+					const double seconds = Time(noiseCase.noise, path == 1, dimensions, size, threads, checksum);
+
+					if (threads == 1)
+					{
+						singleThreadSeconds = seconds;
+					}
+
+					printf("%s,%s,%d,%d,%.2f,%.0f,%.2f\n", noiseCase.name.c_str(), path == 1 ? "FillNoiseSet" : "GetNoise", dimensions, threads,
+						seconds * 1e9 / double(numSamples), double(numSamples) / std::max(seconds, 1e-9), threads * singleThreadSeconds / std::max(seconds, 1e-9));
+				}
+			}
+		}
+	}
+
+	fprintf(stderr, "Checksum %f\n", checksum);
+
+	return 0;
+}
+
+#endif
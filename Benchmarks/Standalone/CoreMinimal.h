@@ -0,0 +1,6 @@
+// CoreMinimal.h
+//
+// Empty stand-in for the engine header included by FastNoise.h, so Benchmarks/FastNoiseBenchmarkStandalone.cpp builds FastNoise.cpp without the engine.
+// Only on the include path of that build, see the command at the top of Benchmarks/FastNoiseBenchmarkStandalone.cpp
+
+#pragma once
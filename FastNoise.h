@@ -38,6 +38,15 @@
 // Uncomment the line below to use doubles throughout FastNoise instead of floats
 //#define FN_USE_DOUBLES
 
+// Comment the line below to always use the scalar code path in FillNoiseSet2D/3D(...)
+// SSE2 evaluates 4 Value, Perlin or Simplex samples at once and returns the same values as the scalar code,
+// as long as the compiler keeps float operations in order (no /fp:fast or -ffast-math)
+#define FN_USE_SIMD
+
+#if defined(FN_USE_SIMD) && !defined(FN_USE_DOUBLES) && (defined(__SSE2__) || defined(_M_X64))
+#define FN_SSE2
+#endif
+
 #define FN_CELLULAR_INDEX_MAX 3
 
 #ifdef FN_USE_DOUBLES
@@ -56,6 +65,7 @@ public:
 	enum FractalType { FBM, Billow, RigidMulti };
 	enum CellularDistanceFunction { Euclidean, Manhattan, Natural };
 	enum CellularReturnType { CellValue, NoiseLookup, Distance, Distance2, Distance2Add, Distance2Sub, Distance2Mul, Distance2Div };
+	enum IndexMode { PermutationTable, IntegerHash };
 
 	// Sets seed used for all noise types
 	// Default: 1337
@@ -64,6 +74,17 @@ public:
 	// Returns seed used for all noise types
 	int GetSeed() const { return m_seed; }
 
+	// Sets how lattice coordinates are hashed into gradient and value indices
+	// Possible index modes:
+	// - PermutationTable: chains 2-4 dependent loads through the permutation tables of the seed
+	// - IntegerHash: mixes the seed and coordinates with integer multiplies and xors, no table loads
+	// IntegerHash produces different noise than PermutationTable for the same seed
+	// Default: PermutationTable
+	void SetIndexMode(IndexMode indexMode) { m_indexMode = indexMode; }
+
+	// Returns the index mode used for all noise types
+	IndexMode GetIndexMode() const { return m_indexMode; }
+
 	// Sets frequency for all noise types
 	// Default: 0.01
 	void SetFrequency(FN_DECIMAL frequency) { m_frequency = frequency; }
@@ -113,11 +134,31 @@ public:
 
 	// Sets method for combining octaves in all fractal noise types
 	// Default: FBM
-	void SetFractalType(FractalType fractalType) { m_fractalType = fractalType; }
+	void SetFractalType(FractalType fractalType) { m_fractalType = fractalType; CalculateFractalBounding(); }
 
 	// Returns method for combining octaves in all fractal noise types
 	FractalType GetFractalType() const { return m_fractalType; }
 
+	// Sets the largest change to the output of fractal noise allowed by skipping the highest octaves
+	// Octaves are left out while the amplitude of all the octaves left out, scaled like the output, is below the threshold
+	// This assumes every octave returns values in [-1, 1], 1/255 keeps 8 bit outputs within one level of the full sum
+	// Default: 0.0 (all octaves)
+	void SetFractalAmplitudeThreshold(FN_DECIMAL threshold) { m_fractalAmplitudeThreshold = threshold; CalculateFractalBounding(); }
+
+	// Returns the amplitude threshold for all fractal noise types
+	FN_DECIMAL GetFractalAmplitudeThreshold() const { return m_fractalAmplitudeThreshold; }
+
+	// Sets the largest number of octaves fractal noise evaluates, the highest octaves beyond it are skipped
+	// The output keeps the scale of the full octave count, e.g. for low detail grids leaving out the octaves finer than their sample spacing
+	// Default: 0 (no limit)
+	void SetFractalOctaveLimit(int octaveLimit) { m_fractalOctaveLimit = octaveLimit; CalculateFractalBounding(); }
+
+	// Returns the octave limit for all fractal noise types
+	int GetFractalOctaveLimit() const { return m_fractalOctaveLimit; }
+
+	// Returns the number of octaves fractal noise evaluates, the octave count minus the octaves skipped by the amplitude threshold and the octave limit
+	int GetFractalOctavesEvaluated() const { return m_octavesEvaluated; }
+
 
 	// Sets distance function used in cellular noise calculations
 	// Default: Euclidean
@@ -136,10 +177,11 @@ public:
 
 	// Noise used to calculate a cell value if cellular return type is NoiseLookup
 	// The lookup value is acquired through GetNoise() so ensure you SetNoiseType() on the noise lookup, value, Perlin or simplex is recommended
-	void SetCellularNoiseLookup(FastNoise* noise) { m_cellularNoiseLookup = noise; }
+	// FillNoiseSet2D/3D(...) evaluate the lookup once per cell, cells without a lookup return 0
+	void SetCellularNoiseLookup(const FastNoise* noise) { m_cellularNoiseLookup = noise; }
 
 	// Returns the noise used to calculate a cell value if the cellular return type is NoiseLookup
-	FastNoise* GetCellularNoiseLookup() const { return m_cellularNoiseLookup; }
+	const FastNoise* GetCellularNoiseLookup() const { return m_cellularNoiseLookup; }
 
 	// Sets the 2 distance indices used for distance2 return types
 	// Default: 0, 1
@@ -165,6 +207,39 @@ public:
 	// Returns the maximum warp distance from original location when using GradientPerturb{Fractal}(...)
 	FN_DECIMAL GetGradientPerturbAmp() const { return m_gradientPerturbAmp; }
 
+	// GetNoise(...) compiled for a single noise type, fractal type and interpolation
+	typedef FN_DECIMAL(*NoiseFunc2D)(const FastNoise& noise, FN_DECIMAL x, FN_DECIMAL y);
+	typedef FN_DECIMAL(*NoiseFunc3D)(const FastNoise& noise, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z);
+
+	// Returns the specialized GetNoise(...) for the current noise type, fractal type and interpolation, with no branches on them
+	// The other settings are read from the FastNoise passed to it, query it again after changing one of those three
+	NoiseFunc2D GetNoiseFunc2D() const;
+	NoiseFunc3D GetNoiseFunc3D() const;
+
+	// Tables read by the noise functions, for backends reimplementing them such as a compute shader
+	// Gradients have 12 entries, the value and cell tables 256
+	struct LookupTables
+	{
+		const FN_DECIMAL* gradX;
+		const FN_DECIMAL* gradY;
+		const FN_DECIMAL* gradZ;
+		const FN_DECIMAL* valLut;
+		const FN_DECIMAL* cell2DX;
+		const FN_DECIMAL* cell2DY;
+		const FN_DECIMAL* cell3DX;
+		const FN_DECIMAL* cell3DY;
+		const FN_DECIMAL* cell3DZ;
+	};
+
+	static const LookupTables& GetLookupTables();
+
+	// Returns the 512 entry permutation tables generated from the seed, the second one modulo 12
+	const unsigned char* GetPermutation() const { return m_perm; }
+	const unsigned char* GetPermutation12() const { return m_perm12; }
+
+	// Returns the scale applied to FBM and Billow fractals, calculated from the octaves and gain
+	FN_DECIMAL GetFractalBounding() const { return m_fractalBounding; }
+
 	//2D
 	FN_DECIMAL GetValue(FN_DECIMAL x, FN_DECIMAL y) const;
 	FN_DECIMAL GetValueFractal(FN_DECIMAL x, FN_DECIMAL y) const;
@@ -185,9 +260,37 @@ public:
 
 	FN_DECIMAL GetNoise(FN_DECIMAL x, FN_DECIMAL y) const;
 
+	// Returns GetNoise(x, y) and writes its partial derivatives along x and y to dx and dy
+	// Analytic for Perlin, Simplex and their fractals, other noise types use central differences
+	FN_DECIMAL GetNoiseWithDerivative(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL& dx, FN_DECIMAL& dy) const;
+
+	// Fills noiseSet with xSize * ySize results of GetNoise(...), x varying fastest
+	// Sample (xi, yi) is taken at (xStart + xi * xStep, yStart + yi * yStep)
+	// The noise function is selected once per call instead of once per sample
+	void FillNoiseSet2D(float* noiseSet, FN_DECIMAL xStart, FN_DECIMAL yStart, int xSize, int ySize, FN_DECIMAL xStep = 1, FN_DECIMAL yStep = 1) const;
+	// Same as FillNoiseSet2D(...), copying every other sample on both axes from coarseSet instead of calculating it
+	// coarseSet holds the ((xSize - 1) / 2 + 1) * ((ySize - 1) / 2 + 1) samples of FillNoiseSet2D(...) at the same start and twice the step
+	void FillRefinedNoiseSet2D(float* noiseSet, const float* coarseSet, FN_DECIMAL xStart, FN_DECIMAL yStart, int xSize, int ySize, FN_DECIMAL xStep = 1, FN_DECIMAL yStep = 1) const;
+
 	void GradientPerturb(FN_DECIMAL& x, FN_DECIMAL& y) const;
 	void GradientPerturbFractal(FN_DECIMAL& x, FN_DECIMAL& y) const;
 
+	// Same as FillNoiseSet2D(...), with each sample position warped by warpNoise.GradientPerturb{Fractal}(...) before sampling
+	// warpNoise can be this FastNoise, its own frequency and gradient perturb amp are used for the warp
+	void FillWarpedNoiseSet2D(float* noiseSet, const FastNoise& warpNoise, bool fractalWarp, FN_DECIMAL xStart, FN_DECIMAL yStart, int xSize, int ySize, FN_DECIMAL xStep = 1, FN_DECIMAL yStep = 1) const;
+
+	// Fills noiseSet with the results of GetNoise(...) at count scattered positions, noiseSet[i] being the noise at (x[i * stride], y[i * stride])
+	// A stride of 1 reads separate x and y arrays, a stride of 2 reads interleaved positions starting at x = &positions[0].x and y = x + 1
+	// Value, Perlin, Simplex and their fractals evaluate 4 positions at once with SSE2, the other noise types one at a time
+	void FillNoiseSetPoints2D(float* noiseSet, const float* x, const float* y, int count, int stride = 1) const;
+
+	// Writes conservative bounds of GetNoise(x, y) over the rectangle [xMin, xMax] x [yMin, yMax] to min and max, every value
+	// of the rectangle lying in [min, max], e.g. to skip the chunks entirely above or below an iso threshold without generating them
+	// The lowest octaves are sampled on samplesPerAxis^2 points and the values between the samples are bounded by the slope or the curvature
+	// of the noise, the octaves too fine for the samples by their amplitude. More samples give tighter bounds for boxes larger than the features
+	// Returns false, writing the whole float range, for the cellular return types other than CellValue
+	bool GetNoiseBounds2D(FN_DECIMAL xMin, FN_DECIMAL yMin, FN_DECIMAL xMax, FN_DECIMAL yMax, FN_DECIMAL& min, FN_DECIMAL& max, int samplesPerAxis = 5) const;
+
 	//3D
 	FN_DECIMAL GetValue(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
 	FN_DECIMAL GetValueFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
@@ -208,11 +311,36 @@ public:
 
 	FN_DECIMAL GetNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
 
+	// Returns GetNoise(x, y, z) and writes its partial derivatives along x, y and z to dx, dy and dz
+	FN_DECIMAL GetNoiseWithDerivative(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL& dx, FN_DECIMAL& dy, FN_DECIMAL& dz) const;
+
+	// Fills noiseSet with xSize * ySize * zSize results of GetNoise(...), x varying fastest and z slowest
+	// Sample (xi, yi, zi) is taken at (xStart + xi * xStep, yStart + yi * yStep, zStart + zi * zStep)
+	void FillNoiseSet3D(float* noiseSet, FN_DECIMAL xStart, FN_DECIMAL yStart, FN_DECIMAL zStart, int xSize, int ySize, int zSize, FN_DECIMAL xStep = 1, FN_DECIMAL yStep = 1, FN_DECIMAL zStep = 1) const;
+
 	void GradientPerturb(FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL& z) const;
 	void GradientPerturbFractal(FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL& z) const;
 
+	// Same as FillNoiseSet3D(...), with each sample position warped by warpNoise.GradientPerturb{Fractal}(...) before sampling
+	void FillWarpedNoiseSet3D(float* noiseSet, const FastNoise& warpNoise, bool fractalWarp, FN_DECIMAL xStart, FN_DECIMAL yStart, FN_DECIMAL zStart, int xSize, int ySize, int zSize, FN_DECIMAL xStep = 1, FN_DECIMAL yStep = 1, FN_DECIMAL zStep = 1) const;
+
+	// Fills noiseSet with the results of GetNoise(...) at count scattered positions, noiseSet[i] being the noise at (x[i * stride], y[i * stride], z[i * stride])
+	// A stride of 1 reads separate x, y and z arrays, a stride of 3 reads interleaved positions starting at x = &positions[0].x, y = x + 1 and z = x + 2
+	void FillNoiseSetPoints3D(float* noiseSet, const float* x, const float* y, const float* z, int count, int stride = 1) const;
+
+	// Writes conservative bounds of GetNoise(x, y, z) over the box [xMin, xMax] x [yMin, yMax] x [zMin, zMax] to min and max,
+	// sampling the lowest octaves on samplesPerAxis^3 points, see GetNoiseBounds2D(...)
+	bool GetNoiseBounds3D(FN_DECIMAL xMin, FN_DECIMAL yMin, FN_DECIMAL zMin, FN_DECIMAL xMax, FN_DECIMAL yMax, FN_DECIMAL zMax, FN_DECIMAL& min, FN_DECIMAL& max, int samplesPerAxis = 5) const;
+
 	//4D
 	FN_DECIMAL GetSimplex(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const;
+	FN_DECIMAL GetSimplexFractal(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const;
+
+	// Fills noiseSet with xSize * ySize samples of a tile wrapping around on both axes, x varying fastest
+	// The tile is a torus in 4D Simplex noise, x and y going around two circles of circumferences xPeriod and yPeriod,
+	// so the features have the same size as in 2D noise sampled xPeriod / xSize and yPeriod / ySize apart
+	// Only Simplex and SimplexFractal have a 4D version, returns false without writing anything for the other noise types
+	bool FillTileableNoiseSet2D(float* noiseSet, int xSize, int ySize, FN_DECIMAL xPeriod, FN_DECIMAL yPeriod) const;
 
 	FN_DECIMAL GetWhiteNoise(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const;
 	FN_DECIMAL GetWhiteNoiseInt(int x, int y, int z, int w) const;
@@ -222,6 +350,7 @@ private:
 	unsigned char m_perm12[512];
 
 	int m_seed = 1337;
+	IndexMode m_indexMode = PermutationTable;
 	FN_DECIMAL m_frequency = FN_DECIMAL(0.01);
 	Interp m_interp = Quintic;
 	NoiseType m_noiseType = Simplex;
@@ -231,10 +360,13 @@ private:
 	FN_DECIMAL m_gain = FN_DECIMAL(0.5);
 	FractalType m_fractalType = FBM;
 	FN_DECIMAL m_fractalBounding;
+	FN_DECIMAL m_fractalAmplitudeThreshold = FN_DECIMAL(0);
+	int m_fractalOctaveLimit = 0;
+	int m_octavesEvaluated = 3;
 
 	CellularDistanceFunction m_cellularDistanceFunction = Euclidean;
 	CellularReturnType m_cellularReturnType = CellValue;
-	FastNoise* m_cellularNoiseLookup = nullptr;
+	const FastNoise* m_cellularNoiseLookup = nullptr;
 	int m_cellularDistanceIndex0 = 0;
 	int m_cellularDistanceIndex1 = 1;
 	FN_DECIMAL m_cellularJitter = FN_DECIMAL(0.45);
@@ -243,6 +375,32 @@ private:
 
 	void CalculateFractalBounding();
 
+	bool GetNoiseBounds(int dimensions, const FN_DECIMAL* boxMin, const FN_DECIMAL* boxMax, FN_DECIMAL& min, FN_DECIMAL& max, int samplesPerAxis) const;
+
+	struct KernelFuncs
+	{
+		NoiseFunc2D getNoise2D;
+		NoiseFunc3D getNoise3D;
+		void(*fillNoiseSet2D)(const FastNoise& noise, float* noiseSet, FN_DECIMAL xStart, FN_DECIMAL yStart, int xSize, int ySize, FN_DECIMAL xStep, FN_DECIMAL yStep);
+		void(*fillNoiseSet3D)(const FastNoise& noise, float* noiseSet, FN_DECIMAL xStart, FN_DECIMAL yStart, FN_DECIMAL zStart, int xSize, int ySize, int zSize, FN_DECIMAL xStep, FN_DECIMAL yStep, FN_DECIMAL zStep);
+	};
+
+	template <NoiseType noiseType, FractalType fractalType, Interp interp> struct Kernel;
+	const KernelFuncs& GetKernel() const;
+
+	// Cellular noise sets computing the jittered cell points once per row of cells, shared by all the samples of the row
+	template <CellularDistanceFunction distanceFunction, bool twoEdge> struct CellularSet;
+	void FillCellularSet(float* noiseSet, FN_DECIMAL xStart, FN_DECIMAL yStart, int xSize, int ySize, FN_DECIMAL xStep, FN_DECIMAL yStep) const;
+	void FillCellularSet(float* noiseSet, FN_DECIMAL xStart, FN_DECIMAL yStart, FN_DECIMAL zStart, int xSize, int ySize, int zSize, FN_DECIMAL xStep, FN_DECIMAL yStep, FN_DECIMAL zStep) const;
+
+#ifdef FN_SSE2
+	bool FillNoiseSetSSE2(float* noiseSet, FN_DECIMAL xStart, FN_DECIMAL yStart, int xSize, int ySize, FN_DECIMAL xStep, FN_DECIMAL yStep) const;
+	bool FillNoiseSetSSE2(float* noiseSet, FN_DECIMAL xStart, FN_DECIMAL yStart, FN_DECIMAL zStart, int xSize, int ySize, int zSize, FN_DECIMAL xStep, FN_DECIMAL yStep, FN_DECIMAL zStep) const;
+	bool FillNoiseSetPointsSSE2(float* noiseSet, const float* x, const float* y, int count, int stride) const;
+	bool FillNoiseSetPointsSSE2(float* noiseSet, const float* x, const float* y, const float* z, int count, int stride) const;
+	void FillTileableNoiseSetSSE2(float* noiseSet, const FN_DECIMAL* xCos, const FN_DECIMAL* xSin, const FN_DECIMAL* yCos, const FN_DECIMAL* ySin, int xSize, int ySize) const;
+#endif
+
 	//2D
 	FN_DECIMAL SingleValueFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const;
 	FN_DECIMAL SingleValueFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const;
@@ -296,7 +454,43 @@ private:
 
 	void SingleGradientPerturb(unsigned char offset, FN_DECIMAL warpAmp, FN_DECIMAL frequency, FN_DECIMAL& x, FN_DECIMAL& y, FN_DECIMAL& z) const;
 
+	// Value and derivatives in a single pass, see GetNoiseWithDerivative(...)
+	FN_DECIMAL SinglePerlinDerivative(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL& dx, FN_DECIMAL& dy) const;
+	FN_DECIMAL SinglePerlinDerivative(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL& dx, FN_DECIMAL& dy, FN_DECIMAL& dz) const;
+	FN_DECIMAL SingleSimplexDerivative(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL& dx, FN_DECIMAL& dy) const;
+	FN_DECIMAL SingleSimplexDerivative(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL& dx, FN_DECIMAL& dy, FN_DECIMAL& dz) const;
+
+	template <typename SingleFunc> FN_DECIMAL SingleFractalDerivative(SingleFunc single, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL& dx, FN_DECIMAL& dy) const;
+	template <typename SingleFunc> FN_DECIMAL SingleFractalDerivative(SingleFunc single, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL& dx, FN_DECIMAL& dy, FN_DECIMAL& dz) const;
+
+	// Interpolation resolved at compile time, the overloads above switch on m_interp
+	template <Interp interp> FN_DECIMAL SingleValueFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const;
+	template <Interp interp> FN_DECIMAL SingleValueFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const;
+	template <Interp interp> FN_DECIMAL SingleValueFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const;
+	template <Interp interp> FN_DECIMAL SingleValue(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const;
+
+	template <Interp interp> FN_DECIMAL SinglePerlinFractalFBM(FN_DECIMAL x, FN_DECIMAL y) const;
+	template <Interp interp> FN_DECIMAL SinglePerlinFractalBillow(FN_DECIMAL x, FN_DECIMAL y) const;
+	template <Interp interp> FN_DECIMAL SinglePerlinFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y) const;
+	template <Interp interp> FN_DECIMAL SinglePerlin(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y) const;
+
+	template <Interp interp> FN_DECIMAL SingleValueFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
+	template <Interp interp> FN_DECIMAL SingleValueFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
+	template <Interp interp> FN_DECIMAL SingleValueFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
+	template <Interp interp> FN_DECIMAL SingleValue(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
+
+	template <Interp interp> FN_DECIMAL SinglePerlinFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
+	template <Interp interp> FN_DECIMAL SinglePerlinFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
+	template <Interp interp> FN_DECIMAL SinglePerlinFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
+	template <Interp interp> FN_DECIMAL SinglePerlin(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z) const;
+
+	template <Interp interp> FN_DECIMAL SinglePerlinDerivative(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL& dx, FN_DECIMAL& dy) const;
+	template <Interp interp> FN_DECIMAL SinglePerlinDerivative(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL& dx, FN_DECIMAL& dy, FN_DECIMAL& dz) const;
+
 	//4D
+	FN_DECIMAL SingleSimplexFractalFBM(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const;
+	FN_DECIMAL SingleSimplexFractalBillow(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const;
+	FN_DECIMAL SingleSimplexFractalRigidMulti(FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const;
 	FN_DECIMAL SingleSimplex(unsigned char offset, FN_DECIMAL x, FN_DECIMAL y, FN_DECIMAL z, FN_DECIMAL w) const;
 
 	inline unsigned char Index2D_12(unsigned char offset, int x, int y) const;
@@ -0,0 +1,148 @@
+// FastNoiseAsyncAction.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "FastNoiseWrapper.h"
+#include "FastNoiseAsyncAction.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FFastNoiseGridGenerated, const TArray<float>&, noise);
+
+/**
+ * Latent blueprint nodes generating noise grids on the task graph, see UFastNoiseWrapper::GetNoise2DGridAsync(...)
+ */
+UCLASS()
+class PROJECT_API UFastNoiseAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Called on the game thread once the grid is generated */
+	UPROPERTY(BlueprintAssignable)
+	FFastNoiseGridGenerated Completed;
+
+	/**
+	* Generates a grid of noise values without blocking the game thread, the output is the same as GetNoise2DGrid(...)
+	*
+	* @param worldContextObject	- object used to keep the node alive until the grid is generated
+	* @param fastNoiseWrapper	- the noise settings, copied when the node executes
+	* @param origin				- the x and y values of the first sample
+	* @param step				- the distance between two consecutive samples on each axis
+	* @param sizeX				- the number of samples along x
+	* @param sizeY				- the number of samples along y
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise", meta = (BlueprintInternalUseOnly = "true", WorldContext = "worldContextObject"))
+	static UFastNoiseAsyncAction* GetNoise2DGridAsync(UObject* worldContextObject, UFastNoiseWrapper* fastNoiseWrapper, const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY)
+	{
+		UFastNoiseAsyncAction* action = NewObject<UFastNoiseAsyncAction>();
+		action->fastNoiseWrapper = fastNoiseWrapper;
+		action->origin = FVector(origin.X, origin.Y, 0.0f);
+		action->step = FVector(step.X, step.Y, 0.0f);
+		action->sizeX = sizeX;
+		action->sizeY = sizeY;
+		action->sizeZ = 1;
+		action->b3D = false;
+		action->RegisterWithGameInstance(worldContextObject);
+
+		return action;
+	}
+
+	/**
+	* Generates a volume of noise values without blocking the game thread, the output is the same as GetNoise3DGrid(...)
+	*
+	* @param worldContextObject	- object used to keep the node alive until the volume is generated
+	* @param fastNoiseWrapper	- the noise settings, copied when the node executes
+	* @param origin				- the x, y and z values of the first sample
+	* @param step				- the distance between two consecutive samples on each axis
+	* @param sizeX				- the number of samples along x
+	* @param sizeY				- the number of samples along y
+	* @param sizeZ				- the number of samples along z
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise", meta = (BlueprintInternalUseOnly = "true", WorldContext = "worldContextObject"))
+	static UFastNoiseAsyncAction* GetNoise3DGridAsync(UObject* worldContextObject, UFastNoiseWrapper* fastNoiseWrapper, const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ)
+	{
+		UFastNoiseAsyncAction* action = NewObject<UFastNoiseAsyncAction>();
+		action->fastNoiseWrapper = fastNoiseWrapper;
+		action->origin = origin;
+		action->step = step;
+		action->sizeX = sizeX;
+		action->sizeY = sizeY;
+		action->sizeZ = sizeZ;
+		action->b3D = true;
+		action->RegisterWithGameInstance(worldContextObject);
+
+		return action;
+	}
+
+	virtual void Activate() override
+	{
+		if (!fastNoiseWrapper)
+		{
+			Completed.Broadcast(TArray<float>());
+			SetReadyToDestroy();
+			return;
+		}
+
+		TFuture<TArray<float>> future = b3D
+			? fastNoiseWrapper->GetNoise3DGridAsync(origin, step, sizeX, sizeY, sizeZ)
+			: fastNoiseWrapper->GetNoise2DGridAsync(FVector2D(origin.X, origin.Y), FVector2D(step.X, step.Y), sizeX, sizeY);
+
+		// The action is registered with the game instance, but it may still be gone if the world is torn down before the grid is ready
+		TWeakObjectPtr<UFastNoiseAsyncAction> weakThis(this);
+
+		future.Then([weakThis](TFuture<TArray<float>> result)
+		{
+			TSharedRef<TArray<float>, ESPMode::ThreadSafe> noise = MakeShared<TArray<float>, ESPMode::ThreadSafe>(result.Get());
+
+			AsyncTask(ENamedThreads::GameThread, [weakThis, noise]()
+			{
+				if (UFastNoiseAsyncAction* action = weakThis.Get())
+				{
+					action->Completed.Broadcast(*noise);
+					action->SetReadyToDestroy();
+				}
+			});
+		});
+	}
+
+private:
+
+	UPROPERTY()
+	UFastNoiseWrapper* fastNoiseWrapper = nullptr;
+
+	FVector origin;
+	FVector step;
+	int32 sizeX = 0;
+	int32 sizeY = 0;
+	int32 sizeZ = 0;
+	bool b3D = false;
+};
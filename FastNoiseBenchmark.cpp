@@ -0,0 +1,370 @@
+// FastNoiseBenchmark.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseBenchmark.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFastNoiseBenchmark, Log, All);
+
+namespace FastNoiseBenchmark
+{
+	static const TCHAR* NoiseTypeNames[] = { TEXT("Value"), TEXT("ValueFractal"), TEXT("Perlin"), TEXT("PerlinFractal"), TEXT("Simplex"), TEXT("SimplexFractal"), TEXT("Cellular"), TEXT("WhiteNoise"), TEXT("Cubic"), TEXT("CubicFractal") };
+	static const TCHAR* FractalTypeNames[] = { TEXT("FBM"), TEXT("Billow"), TEXT("RigidMulti") };
+	static const TCHAR* DistanceFunctionNames[] = { TEXT("Euclidean"), TEXT("Manhattan"), TEXT("Natural") };
+	static const TCHAR* ReturnTypeNames[] = { TEXT("CellValue"), TEXT("NoiseLookup"), TEXT("Distance"), TEXT("Distance2"), TEXT("Distance2Add"), TEXT("Distance2Sub"), TEXT("Distance2Mul"), TEXT("Distance2Div") };
+
+	struct FCase
+	{
+		FString name;
+		FastNoise noise;
+	};
+
+	/** Generates one grid the way the given path does, returns a checksum so the work can't be optimized away */
+	static float Generate(const FastNoise& noise, const bool bFillNoiseSet, const int32 dimensions, const int32 size, TArray<float>& buffer)
+	{
+		float checksum = 0.0f;
+
+		if (dimensions == 2 && bFillNoiseSet)
+		{
+			noise.FillNoiseSet2D(buffer.GetData(), 0, 0, size, size);
+			checksum = buffer[buffer.Num() - 1];
+		}
+		else if (dimensions == 3 && bFillNoiseSet)
+		{
+			noise.FillNoiseSet3D(buffer.GetData(), 0, 0, 0, size, size, size);
+			checksum = buffer[buffer.Num() - 1];
+		}
+		else if (dimensions == 2)
+		{
+			for (int32 y = 0; y < size; y++)
+				for (int32 x = 0; x < size; x++)
+					checksum += noise.GetNoise(x, y);
+		}
+		else if (dimensions == 3)
+		{
+			for (int32 z = 0; z < size; z++)
+				for (int32 y = 0; y < size; y++)
+					for (int32 x = 0; x < size; x++)
+						checksum += noise.GetNoise(x, y, z);
+		}
+		else
+		{
+			// FastNoise only has 4D Simplex and White Noise, sampled on a gridSize^2 slice moving along z and w
+			const bool bWhiteNoise = noise.GetNoiseType() == FastNoise::WhiteNoise;
+
+			for (int32 y = 0; y < size; y++)
+				for (int32 x = 0; x < size; x++)
+					checksum += bWhiteNoise ? noise.GetWhiteNoise(x, y, x + y, x - y) : noise.GetSimplex(x, y, x + y, x - y);
+		}
+
+		return checksum;
+	}
+
+	/** Returns the seconds taken to generate the grid on each of numThreads concurrent tasks, the fastest of NumRepetitions runs */
+	static double Time(const FastNoise& noise, const bool bFillNoiseSet, const int32 dimensions, const int32 size, const int32 numThreads, float& checksum)
+	{
+		const int32 numSamples = dimensions == 3 ? size * size * size : size * size;
+		TArray<TArray<float>> buffers;
+		TArray<float> checksums;
+		buffers.SetNum(numThreads);
+		checksums.SetNumZeroed(numThreads);
+
+		for (TArray<float>& buffer : buffers)
+		{
+			buffer.SetNumUninitialized(numSamples);
+		}
+
+		// Warm up caches and the task graph before timing
+		checksum += Generate(noise, bFillNoiseSet, dimensions, size, buffers[0]);
+
+		double seconds = MAX_dbl;
+
+		for (int32 repetition = 0; repetition < FFastNoiseBenchmark::NumRepetitions; repetition++)
+		{
+			const double start = FPlatformTime::Seconds();
+			ParallelFor(numThreads, [&](const int32 thread)
+			{
+				checksums[thread] = Generate(noise, bFillNoiseSet, dimensions, size, buffers[thread]);
+			}, numThreads == 1);
+			seconds = FMath::Min(seconds, FPlatformTime::Seconds() - start);
+
+			for (const float threadChecksum : checksums)
+			{
+				checksum += threadChecksum;
+			}
+		}
+
+		return seconds;
+	}
+
+	static TArray<FCase> MakeCases()
+	{
+		TArray<FCase> cases;
+
+		for (int32 noiseType = 0; noiseType < UE_ARRAY_COUNT(NoiseTypeNames); noiseType++)
+		{
+			const bool bFractal = noiseType == FastNoise::ValueFractal || noiseType == FastNoise::PerlinFractal || noiseType == FastNoise::SimplexFractal || noiseType == FastNoise::CubicFractal;
+
+			if (noiseType == FastNoise::Cellular)
+			{
+				for (int32 distanceFunction = 0; distanceFunction < UE_ARRAY_COUNT(DistanceFunctionNames); distanceFunction++)
+				{
+					for (int32 returnType = 0; returnType < UE_ARRAY_COUNT(ReturnTypeNames); returnType++)
+					{
+						FCase& cellularCase = cases.AddDefaulted_GetRef();
+						cellularCase.name = FString::Printf(TEXT("Cellular%s %s"), ReturnTypeNames[returnType], DistanceFunctionNames[distanceFunction]);
+						cellularCase.noise.SetNoiseType(FastNoise::Cellular);
+						cellularCase.noise.SetCellularDistanceFunction(FastNoise::CellularDistanceFunction(distanceFunction));
+						cellularCase.noise.SetCellularReturnType(FastNoise::CellularReturnType(returnType));
+					}
+				}
+			}
+			else
+			{
+				for (int32 fractalType = 0; fractalType < (bFractal ? UE_ARRAY_COUNT(FractalTypeNames) : 1); fractalType++)
+				{
+					FCase& noiseCase = cases.AddDefaulted_GetRef();
+					noiseCase.name = bFractal ? FString::Printf(TEXT("%s %s"), NoiseTypeNames[noiseType], FractalTypeNames[fractalType]) : FString(NoiseTypeNames[noiseType]);
+					noiseCase.noise.SetNoiseType(FastNoise::NoiseType(noiseType));
+					noiseCase.noise.SetFractalType(FastNoise::FractalType(fractalType));
+				}
+			}
+		}
+
+		// Every case again with the integer hash index mode, White Noise doesn't index the tables in either mode
+		const int32 numTableCases = cases.Num();
+		for (int32 i = 0; i < numTableCases; i++)
+		{
+			if (cases[i].noise.GetNoiseType() != FastNoise::WhiteNoise)
+			{
+				FCase hashCase = cases[i];
+				hashCase.name += TEXT(" IntegerHash");
+				hashCase.noise.SetIndexMode(FastNoise::IntegerHash);
+				cases.Add(MoveTemp(hashCase));
+			}
+		}
+
+		return cases;
+	}
+}
+
+TArray<FFastNoiseBenchmark::FResult> FFastNoiseBenchmark::Run(const int32 gridSize, const int32 maxThreads)
+{
+	using namespace FastNoiseBenchmark;
+
+	// Lookup for the NoiseLookup cellular cases, kept alive for the whole run
+	FastNoise lookup;
+	lookup.SetNoiseType(FastNoise::Simplex);
+
+	TArray<FCase> cases = MakeCases();
+	TArray<FResult> results;
+	const int32 threadLimit = maxThreads > 0 ? maxThreads : FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	float checksum = 0.0f;
+
+	for (FCase& noiseCase : cases)
+	{
+		noiseCase.noise.SetCellularNoiseLookup(&lookup);
+		const bool bHas4D = noiseCase.noise.GetNoiseType() == FastNoise::Simplex || noiseCase.noise.GetNoiseType() == FastNoise::WhiteNoise;
+
+		for (int32 dimensions = 2; dimensions <= 4; dimensions++)
+		{
+			if (dimensions == 4 && !bHas4D)
+			{
+				continue;
+			}
+
+			const int32 size = dimensions == 3 ? FMath::Max(1, gridSize / 4) : gridSize;
+			const int32 numSamples = dimensions == 3 ? size * size * size : size * size;
+
+			for (int32 path = 0; path < (dimensions == 4 ? 1 : 2); path++)
+			{
+				double singleThreadSeconds = 0.0;
+
+				for (int32 threads = 1; threads <= threadLimit; threads *= 2)
+				{
+					const double seconds = Time(noiseCase.noise, path == 1, dimensions, size, threads, checksum);
+
+					FResult& result = results.AddDefaulted_GetRef();
+					result.name = noiseCase.name;
+					result.path = path == 1 ? TEXT("FillNoiseSet") : TEXT("GetNoise");
+					result.dimensions = dimensions;
+					result.threads = threads;
+					result.nsPerSample = seconds * 1e9 / double(numSamples);
+					result.samplesPerSecondPerCore = double(numSamples) / FMath::Max(seconds, 1e-9);
+
+					if (threads == 1)
+					{
+						singleThreadSeconds = seconds;
+					}
+
+					result.scaling = threads * singleThreadSeconds / FMath::Max(seconds, 1e-9);
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogFastNoiseBenchmark, Verbose, TEXT("Checksum %f"), checksum);
+
+	return results;
+}
+
+FString FFastNoiseBenchmark::ToCSV(const TArray<FResult>& results)
+{
+	FString csv = TEXT("Case,Path,Dimensions,Threads,NsPerSample,SamplesPerSecondPerCore,Scaling\n");
+
+	for (const FResult& result : results)
+	{
+		csv += FString::Printf(TEXT("%s,%s,%d,%d,%.2f,%.0f,%.2f\n"), *result.name, *result.path, result.dimensions, result.threads, result.nsPerSample, result.samplesPerSecondPerCore, result.scaling);
+	}
+
+	return csv;
+}
+
+TArray<FFastNoiseBenchmark::FResult> FFastNoiseBenchmark::FromCSV(const FString& csv)
+{
+	TArray<FString> lines;
+	csv.ParseIntoArrayLines(lines);
+
+	TArray<FResult> results;
+
+	// The first line is the header
+	for (int32 line = 1; line < lines.Num(); line++)
+	{
+		TArray<FString> fields;
+		lines[line].ParseIntoArray(fields, TEXT(","), false);
+
+		if (fields.Num() != 7)
+		{
+			continue;
+		}
+
+		FResult& result = results.AddDefaulted_GetRef();
+		result.name = fields[0];
+		result.path = fields[1];
+		result.dimensions = FCString::Atoi(*fields[2]);
+		result.threads = FCString::Atoi(*fields[3]);
+		result.nsPerSample = FCString::Atod(*fields[4]);
+		result.samplesPerSecondPerCore = FCString::Atod(*fields[5]);
+		result.scaling = FCString::Atod(*fields[6]);
+	}
+
+	return results;
+}
+
+TArray<FFastNoiseBenchmark::FDelta> FFastNoiseBenchmark::Compare(const TArray<FResult>& results, const TArray<FResult>& baseline)
+{
+	TMap<FString, const FResult*> baselineResults;
+
+	for (const FResult& result : baseline)
+	{
+		baselineResults.Add(FString::Printf(TEXT("%s,%s,%d,%d"), *result.name, *result.path, result.dimensions, result.threads), &result);
+	}
+
+	TArray<FDelta> deltas;
+
+	for (const FResult& result : results)
+	{
+		const FResult* const* baselineResult = baselineResults.Find(FString::Printf(TEXT("%s,%s,%d,%d"), *result.name, *result.path, result.dimensions, result.threads));
+
+		if (!baselineResult || (*baselineResult)->nsPerSample <= 0.0)
+		{
+			continue;
+		}
+
+		FDelta& delta = deltas.AddDefaulted_GetRef();
+		delta.result = result;
+		delta.baseline = **baselineResult;
+		delta.change = result.nsPerSample / delta.baseline.nsPerSample - 1.0;
+	}
+
+	return deltas;
+}
+
+FString FFastNoiseBenchmark::GetBaselinePath()
+{
+	return FPaths::Combine(FPaths::GetPath(FString(ANSI_TO_TCHAR(__FILE__))), TEXT("Benchmarks"), TEXT("Baseline.csv"));
+}
+
+static FAutoConsoleCommand FastNoiseBenchmarkCommand
+(
+	TEXT("FastNoise.Benchmark"),
+	TEXT("Benchmarks every FastNoise setting and compares it to a baseline. Usage: FastNoise.Benchmark [gridSize = 256] [maxThreads = all workers] [baseline = Benchmarks/Baseline.csv]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& args)
+	{
+		const int32 gridSize = args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*args[0])) : 256;
+		const int32 maxThreads = args.Num() > 1 ? FCString::Atoi(*args[1]) : 0;
+
+		const TArray<FFastNoiseBenchmark::FResult> results = FFastNoiseBenchmark::Run(gridSize, maxThreads);
+
+		for (const FFastNoiseBenchmark::FResult& result : results)
+		{
+			UE_LOG(LogFastNoiseBenchmark, Display, TEXT("%-32s %-12s %dD %2d threads: %8.2f ns/sample %12.0f samples/s per core, scaling %.2f"),
+				*result.name, *result.path, result.dimensions, result.threads, result.nsPerSample, result.samplesPerSecondPerCore, result.scaling);
+		}
+
+		const FString csvPath = FPaths::ProjectSavedDir() / TEXT("FastNoise") / TEXT("Benchmark.csv");
+		FFileHelper::SaveStringToFile(FFastNoiseBenchmark::ToCSV(results), *csvPath);
+		UE_LOG(LogFastNoiseBenchmark, Display, TEXT("Results saved to %s"), *csvPath);
+
+		const FString baselinePath = args.Num() > 2 ? args[2] : FFastNoiseBenchmark::GetBaselinePath();
+		FString baselineCSV;
+
+		if (!FFileHelper::LoadFileToString(baselineCSV, *baselinePath))
+		{
+			UE_LOG(LogFastNoiseBenchmark, Warning, TEXT("No baseline at %s"), *baselinePath);
+			return;
+		}
+
+		const TArray<FFastNoiseBenchmark::FDelta> deltas = FFastNoiseBenchmark::Compare(results, FFastNoiseBenchmark::FromCSV(baselineCSV));
+		int32 numRegressions = 0;
+
+		for (const FFastNoiseBenchmark::FDelta& delta : deltas)
+		{
+			const bool bRegression = delta.change > FFastNoiseBenchmark::RegressionThreshold;
+			numRegressions += bRegression;
+
+			if (bRegression)
+			{
+				UE_LOG(LogFastNoiseBenchmark, Warning, TEXT("%-32s %-12s %dD %2d threads: %8.2f ns/sample, baseline %8.2f, %+.1f%%"),
+					*delta.result.name, *delta.result.path, delta.result.dimensions, delta.result.threads, delta.result.nsPerSample, delta.baseline.nsPerSample, delta.change * 100.0);
+			}
+			else
+			{
+				UE_LOG(LogFastNoiseBenchmark, Display, TEXT("%-32s %-12s %dD %2d threads: %8.2f ns/sample, baseline %8.2f, %+.1f%%"),
+					*delta.result.name, *delta.result.path, delta.result.dimensions, delta.result.threads, delta.result.nsPerSample, delta.baseline.nsPerSample, delta.change * 100.0);
+			}
+		}
+
+		UE_LOG(LogFastNoiseBenchmark, Display, TEXT("%d of %d results compared to %s are more than %.0f%% slower"), numRegressions, deltas.Num(), *baselinePath, FFastNoiseBenchmark::RegressionThreshold * 100.0);
+	})
+);
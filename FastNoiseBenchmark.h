@@ -0,0 +1,98 @@
+// FastNoiseBenchmark.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FastNoise.h"
+
+/**
+ * Benchmark sweeping every FastNoise noise type, fractal type and cellular setting in 2D, 3D and 4D.
+ * Run it with the console command FastNoise.Benchmark [gridSize] [maxThreads] [baseline], results are logged and saved as CSV
+ * in Saved/FastNoise/Benchmark.csv, then compared to the baseline checked in as Benchmarks/Baseline.csv.
+ * Benchmarks/FastNoiseBenchmarkStandalone.cpp runs the same sweep without the engine to measure that baseline, keep both in sync
+ */
+class PROJECT_API FFastNoiseBenchmark
+{
+public:
+
+	struct FResult
+	{
+		/** Settings of the case, e.g. "CellularDistance2Add Manhattan" */
+		FString name;
+		/** Sampling path, GetNoise or FillNoiseSet */
+		FString path;
+		int32 dimensions = 0;
+		/** Number of grids generated concurrently */
+		int32 threads = 1;
+		/** Average time per sample on one thread */
+		double nsPerSample = 0.0;
+		/** Samples per second, divided by the number of threads */
+		double samplesPerSecondPerCore = 0.0;
+		/** Total throughput relative to the single thread run of the same case */
+		double scaling = 1.0;
+	};
+
+	struct FDelta
+	{
+		/** The result and the baseline result of the same case, path, dimensions and threads */
+		FResult result;
+		FResult baseline;
+		/** Relative change of the time per sample, positive when slower than the baseline */
+		double change = 0.0;
+	};
+
+	/** Number of times each grid is timed, the fastest run being kept so the results are less noisy */
+	static constexpr int32 NumRepetitions = 3;
+
+	/** Change of the time per sample above which a result is reported as a regression */
+	static constexpr double RegressionThreshold = 0.1;
+
+	/**
+	* Runs the whole sweep, each case generates a gridSize^2 grid in 2D and 4D and a (gridSize / 4)^3 volume in 3D.
+	* Thread scaling is measured by generating the same grid on 1, 2, 4... up to maxThreads tasks at the same time
+	*
+	* @param gridSize	- the number of samples on each axis of the 2D grids
+	* @param maxThreads	- the maximum number of concurrent tasks, 0 to use every worker thread
+	* @return one result per case, path, dimension and thread count
+	*/
+	static TArray<FResult> Run(const int32 gridSize = 256, const int32 maxThreads = 0);
+
+	/** Formats results as CSV, one line per result after a header line */
+	static FString ToCSV(const TArray<FResult>& results);
+
+	/** Parses CSV written by ToCSV(...), lines that don't parse are skipped */
+	static TArray<FResult> FromCSV(const FString& csv);
+
+	/** Pairs each result with the baseline result of the same case, path, dimensions and threads, results missing from the baseline are skipped */
+	static TArray<FDelta> Compare(const TArray<FResult>& results, const TArray<FResult>& baseline);
+
+	/** Returns the path of the baseline checked in next to the sources */
+	static FString GetBaselinePath();
+};
@@ -0,0 +1,138 @@
+// FastNoiseBufferPool.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseBufferPool.h"
+
+FFastNoiseBuffer& FFastNoiseBuffer::operator=(FFastNoiseBuffer&& other)
+{
+	if (this != &other)
+	{
+		Release();
+
+		pool = other.pool;
+		data = MoveTemp(other.data);
+		num = other.num;
+
+		other.pool = nullptr;
+		other.num = 0;
+	}
+
+	return *this;
+}
+
+void FFastNoiseBuffer::Release()
+{
+	if (pool)
+	{
+		pool->Release(MoveTemp(data));
+	}
+
+	pool = nullptr;
+	data.Empty();
+	num = 0;
+}
+
+FFastNoiseBufferPool::~FFastNoiseBufferPool()
+{
+	Trim();
+}
+
+FFastNoiseBufferPool& FFastNoiseBufferPool::Get()
+{
+	static FFastNoiseBufferPool pool;
+	return pool;
+}
+
+FFastNoiseBuffer FFastNoiseBufferPool::Acquire(const int32 numSamples)
+{
+	const int32 sizeClass = GetSizeClass(numSamples);
+
+	FFastNoiseBuffer buffer;
+	buffer.pool = this;
+	buffer.num = FMath::Max(numSamples, 0);
+
+	{
+		FScopeLock lock(&poolLock);
+
+		if (freeBuffers.IsValidIndex(sizeClass) && freeBuffers[sizeClass].Num() > 0)
+		{
+			buffer.data = freeBuffers[sizeClass].Pop(false);
+			pooledBytes -= buffer.data.Num() * sizeof(float);
+			return buffer;
+		}
+	}
+
+	// Allocated outside of the lock, at the full capacity of the size class so the buffer can be reused for any size of the class
+	buffer.data.SetNumUninitialized(1 << sizeClass);
+	numAllocations++;
+
+	return buffer;
+}
+
+void FFastNoiseBufferPool::Trim()
+{
+	FScopeLock lock(&poolLock);
+
+	freeBuffers.Empty();
+	pooledBytes = 0;
+}
+
+int64 FFastNoiseBufferPool::GetPooledBytes() const
+{
+	FScopeLock lock(&poolLock);
+
+	return pooledBytes;
+}
+
+void FFastNoiseBufferPool::Release(FFastNoiseAlignedArray&& data)
+{
+	const int64 bytes = data.Num() * sizeof(float);
+
+	if (bytes == 0)
+	{
+		return;
+	}
+
+	FScopeLock lock(&poolLock);
+
+	if (pooledBytes + bytes > maxPooled)
+	{
+		return;
+	}
+
+	const int32 sizeClass = FMath::CeilLogTwo(uint32(data.Num()));
+
+	if (freeBuffers.Num() <= sizeClass)
+	{
+		freeBuffers.SetNum(sizeClass + 1);
+	}
+
+	freeBuffers[sizeClass].Add(MoveTemp(data));
+	pooledBytes += bytes;
+}
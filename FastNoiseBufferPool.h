@@ -0,0 +1,121 @@
+// FastNoiseBufferPool.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+
+/** Noise values aligned to a cache line, rows of a multiple of 4 samples use the aligned SSE2 stores of FillNoiseSet2D/3D(...) */
+typedef TArray<float, TAlignedHeapAllocator<64>> FFastNoiseAlignedArray;
+
+class FFastNoiseBufferPool;
+
+/**
+ * Buffer of noise values drawn from a FFastNoiseBufferPool, given back to it by Release() or when destroyed.
+ * It can be moved but not copied, so a buffer always has a single owner
+ */
+class PROJECT_API FFastNoiseBuffer
+{
+public:
+
+	FFastNoiseBuffer() = default;
+	FFastNoiseBuffer(FFastNoiseBuffer&& other) { *this = MoveTemp(other); }
+	FFastNoiseBuffer& operator=(FFastNoiseBuffer&& other);
+	FFastNoiseBuffer(const FFastNoiseBuffer&) = delete;
+	FFastNoiseBuffer& operator=(const FFastNoiseBuffer&) = delete;
+	~FFastNoiseBuffer() { Release(); }
+
+	/** Gives the memory back to the pool, the buffer is empty afterwards */
+	void Release();
+
+	float* GetData() { return data.GetData(); }
+	const float* GetData() const { return data.GetData(); }
+
+	/** Returns the number of samples asked for, the allocation may be larger */
+	int32 Num() const { return num; }
+
+	/** Returns the samples, to be filled by e.g. UFastNoiseWrapper::FillNoise2DGrid(...) */
+	TArrayView<float> GetView() { return TArrayView<float>(data.GetData(), num); }
+	TArrayView<const float> GetView() const { return TArrayView<const float>(data.GetData(), num); }
+
+private:
+
+	friend class FFastNoiseBufferPool;
+
+	FFastNoiseBufferPool* pool = nullptr;
+	FFastNoiseAlignedArray data;
+	int32 num = 0;
+};
+
+/**
+ * Thread safe pool of 64 byte aligned noise buffers, so generating many grids of similar sizes doesn't allocate once the pool is warm.
+ * Buffers are grouped by power of two capacities, and released buffers are freed instead of kept once maxPooledBytes are pooled
+ */
+class PROJECT_API FFastNoiseBufferPool
+{
+public:
+
+	/** Smallest capacity of a buffer, in samples */
+	static constexpr int32 MinBufferSamples = 1024;
+
+	explicit FFastNoiseBufferPool(const int64 maxPooledBytes = 256 * 1024 * 1024) : maxPooled(maxPooledBytes) {}
+	~FFastNoiseBufferPool();
+
+	/** Returns the pool shared by the whole module */
+	static FFastNoiseBufferPool& Get();
+
+	/** Returns an uninitialized buffer of numSamples samples, reusing a released one if any */
+	FFastNoiseBuffer Acquire(const int32 numSamples);
+
+	/** Frees every pooled buffer, the buffers in use are given back to the pool as usual */
+	void Trim();
+
+	/** Returns the memory held by the released buffers, in bytes */
+	int64 GetPooledBytes() const;
+
+	/** Returns the number of buffers allocated since the pool was created, a warm pool stops allocating */
+	int64 GetNumAllocations() const { return numAllocations.Load(); }
+
+private:
+
+	friend class FFastNoiseBuffer;
+
+	void Release(FFastNoiseAlignedArray&& data);
+
+	static int32 GetSizeClass(const int32 numSamples) { return FMath::CeilLogTwo(uint32(FMath::Max(numSamples, MinBufferSamples))); }
+
+	/** Released buffers of capacity 2^sizeClass at index sizeClass */
+	TArray<TArray<FFastNoiseAlignedArray>> freeBuffers;
+	mutable FCriticalSection poolLock;
+
+	int64 maxPooled;
+	int64 pooledBytes = 0;
+	TAtomic<int64> numAllocations { 0 };
+};
@@ -0,0 +1,367 @@
+// FastNoiseChunk.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseChunk.h"
+#include "FastNoiseStats.h"
+#include "Misc/Compression.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFastNoiseChunk, Log, All);
+
+namespace FastNoiseChunk
+{
+	/** Replaces the levels by their differences with the previous ones, 16 bit differences being split into a plane of low bytes then a plane of high bytes */
+	static void DeltaEncode(const TArray<uint8>& levels, const bool b16Bits, TArray<uint8>& outFiltered)
+	{
+		outFiltered.SetNumUninitialized(levels.Num());
+
+		if (b16Bits)
+		{
+			const uint16* levels16 = reinterpret_cast<const uint16*>(levels.GetData());
+			const int32 num = levels.Num() / 2;
+			uint16 previous = 0;
+
+			for (int32 i = 0; i < num; i++)
+			{
+				const uint16 delta = uint16(levels16[i] - previous);
+				outFiltered[i] = uint8(delta);
+				outFiltered[num + i] = uint8(delta >> 8);
+				previous = levels16[i];
+			}
+		}
+		else
+		{
+			uint8 previous = 0;
+
+			for (int32 i = 0; i < levels.Num(); i++)
+			{
+				outFiltered[i] = uint8(levels[i] - previous);
+				previous = levels[i];
+			}
+		}
+	}
+
+	/** Inverse of DeltaEncode(...) */
+	static void DeltaDecode(const TArray<uint8>& filtered, const bool b16Bits, TArray<uint8>& outLevels)
+	{
+		outLevels.SetNumUninitialized(filtered.Num());
+
+		if (b16Bits)
+		{
+			uint16* levels16 = reinterpret_cast<uint16*>(outLevels.GetData());
+			const int32 num = filtered.Num() / 2;
+			uint16 previous = 0;
+
+			for (int32 i = 0; i < num; i++)
+			{
+				previous = uint16(previous + (filtered[i] | (filtered[num + i] << 8)));
+				levels16[i] = previous;
+			}
+		}
+		else
+		{
+			uint8 previous = 0;
+
+			for (int32 i = 0; i < filtered.Num(); i++)
+			{
+				previous = uint8(previous + filtered[i]);
+				outLevels[i] = previous;
+			}
+		}
+	}
+}
+
+bool FFastNoiseChunkLayout::IsSupported(const EFastNoise_ChunkLayout layout, const int32 size)
+{
+	switch (layout)
+	{
+	case EFastNoise_ChunkLayout::Linear:
+		return size > 0;
+	case EFastNoise_ChunkLayout::Morton:
+		// SpreadBits(...) interleaves 10 bits per axis
+		return size > 0 && size <= 1024 && FMath::IsPowerOfTwo(size);
+	case EFastNoise_ChunkLayout::Bricked:
+		return size > 0 && size % BrickSize == 0;
+	default:
+		return false;
+	}
+}
+
+void FFastNoiseChunkLayout::GetAxisOffsets(const EFastNoise_ChunkLayout layout, const int32 size, TArray<int32>& outX, TArray<int32>& outY, TArray<int32>& outZ)
+{
+	outX.SetNumUninitialized(size);
+	outY.SetNumUninitialized(size);
+	outZ.SetNumUninitialized(size);
+
+	for (int32 i = 0; i < size; i++)
+	{
+		outX[i] = GetAxisOffset(layout, size, 0, i);
+		outY[i] = GetAxisOffset(layout, size, 1, i);
+		outZ[i] = GetAxisOffset(layout, size, 2, i);
+	}
+}
+
+bool FFastNoiseChunkLayout::FillNoise3DChunk(const FastNoise& noise, const FVector& origin, const FVector& step, const int32 size, const EFastNoise_ChunkLayout layout, TArrayView<float> outNoise)
+{
+	if (!IsSupported(layout, size) || outNoise.Num() < size * size * size)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_FillNoise3DChunk);
+	FastNoiseStats::AddSamples(noise.GetNoiseType(), int64(size) * size * size);
+
+	// One row at a time, like UFastNoiseWrapper::GetNoise3DGrid(...), so the values are the same whatever the layout
+	if (layout == EFastNoise_ChunkLayout::Linear)
+	{
+		for (int32 row = 0; row < size * size; row++)
+		{
+			noise.FillNoiseSet3D(outNoise.GetData() + row * size, origin.X, origin.Y + (row % size) * step.Y, origin.Z + (row / size) * step.Z, size, 1, 1, step.X, step.Y, step.Z);
+		}
+
+		return true;
+	}
+
+	TArray<int32> offsetsX, offsetsY, offsetsZ;
+	GetAxisOffsets(layout, size, offsetsX, offsetsY, offsetsZ);
+
+	TArray<float, TAlignedHeapAllocator<64>> rowNoise;
+	rowNoise.SetNumUninitialized(size);
+
+	for (int32 k = 0; k < size; k++)
+	{
+		for (int32 j = 0; j < size; j++)
+		{
+			noise.FillNoiseSet3D(rowNoise.GetData(), origin.X, origin.Y + j * step.Y, origin.Z + k * step.Z, size, 1, 1, step.X, step.Y, step.Z);
+
+			float* rowStart = outNoise.GetData() + offsetsY[j] + offsetsZ[k];
+
+			for (int32 i = 0; i < size; i++)
+			{
+				rowStart[offsetsX[i]] = rowNoise[i];
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FFastNoiseChunkLayout::Reorder(TArrayView<const float> noise, const EFastNoise_ChunkLayout layout, TArrayView<float> outNoise, const EFastNoise_ChunkLayout outLayout, const int32 size)
+{
+	const int32 numSamples = size * size * size;
+
+	if (!IsSupported(layout, size) || !IsSupported(outLayout, size) || noise.Num() < numSamples || outNoise.Num() < numSamples)
+	{
+		return false;
+	}
+
+	if (layout == outLayout)
+	{
+		FMemory::Memcpy(outNoise.GetData(), noise.GetData(), numSamples * sizeof(float));
+		return true;
+	}
+
+	TArray<int32> offsetsX, offsetsY, offsetsZ, outOffsetsX, outOffsetsY, outOffsetsZ;
+	GetAxisOffsets(layout, size, offsetsX, offsetsY, offsetsZ);
+	GetAxisOffsets(outLayout, size, outOffsetsX, outOffsetsY, outOffsetsZ);
+
+	for (int32 k = 0; k < size; k++)
+	{
+		for (int32 j = 0; j < size; j++)
+		{
+			const float* row = noise.GetData() + offsetsY[j] + offsetsZ[k];
+			float* outRow = outNoise.GetData() + outOffsetsY[j] + outOffsetsZ[k];
+
+			for (int32 i = 0; i < size; i++)
+			{
+				outRow[outOffsetsX[i]] = row[offsetsX[i]];
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FFastNoiseQuantizedChunk::Quantize(TArrayView<const float> noise, const int32 chunkSize, const EFastNoise_ChunkLayout chunkLayout, const EFastNoise_ChunkQuantization chunkQuantization)
+{
+	Empty();
+
+	const int32 numSamples = chunkSize * chunkSize * chunkSize;
+
+	if (!FFastNoiseChunkLayout::IsSupported(chunkLayout, chunkSize) || noise.Num() < numSamples)
+	{
+		return false;
+	}
+
+	size = chunkSize;
+	layout = chunkLayout;
+	quantization = chunkQuantization;
+
+	float minNoise = noise[0];
+	float maxNoise = noise[0];
+
+	for (int32 i = 1; i < numSamples; i++)
+	{
+		minNoise = FMath::Min(minNoise, noise[i]);
+		maxNoise = FMath::Max(maxNoise, noise[i]);
+	}
+
+	const bool b16Bits = quantization == EFastNoise_ChunkQuantization::Bits16;
+	const float maxLevel = b16Bits ? 65535.0f : 255.0f;
+
+	offset = minNoise;
+	scale = (maxNoise - minNoise) / maxLevel;
+
+	// Uniform chunks only have level 0
+	const float toLevel = scale > 0.0f ? 1.0f / scale : 0.0f;
+
+	data.SetNumUninitialized(GetNumBytes());
+
+	if (b16Bits)
+	{
+		uint16* levels = reinterpret_cast<uint16*>(data.GetData());
+
+		for (int32 i = 0; i < numSamples; i++)
+		{
+			levels[i] = uint16(FMath::Min((noise[i] - offset) * toLevel + 0.5f, maxLevel));
+		}
+	}
+	else
+	{
+		for (int32 i = 0; i < numSamples; i++)
+		{
+			data[i] = uint8(FMath::Min((noise[i] - offset) * toLevel + 0.5f, maxLevel));
+		}
+	}
+
+	return true;
+}
+
+bool FFastNoiseQuantizedChunk::Dequantize(TArrayView<float> outNoise) const
+{
+	const int32 numSamples = size * size * size;
+
+	if (IsEmpty() || outNoise.Num() < numSamples)
+	{
+		return false;
+	}
+
+	const TArray<uint8>* levels = &data;
+	TArray<uint8> decompressed;
+
+	if (bCompressed)
+	{
+		FFastNoiseQuantizedChunk chunk = *this;
+
+		if (!chunk.Decompress())
+		{
+			return false;
+		}
+
+		decompressed = MoveTemp(chunk.data);
+		levels = &decompressed;
+	}
+
+	if (quantization == EFastNoise_ChunkQuantization::Bits16)
+	{
+		const uint16* levels16 = reinterpret_cast<const uint16*>(levels->GetData());
+
+		for (int32 i = 0; i < numSamples; i++)
+		{
+			outNoise[i] = offset + levels16[i] * scale;
+		}
+	}
+	else
+	{
+		for (int32 i = 0; i < numSamples; i++)
+		{
+			outNoise[i] = offset + (*levels)[i] * scale;
+		}
+	}
+
+	return true;
+}
+
+bool FFastNoiseQuantizedChunk::Compress()
+{
+	if (bCompressed || IsEmpty())
+	{
+		return bCompressed;
+	}
+
+	TArray<uint8> filtered;
+	FastNoiseChunk::DeltaEncode(data, quantization == EFastNoise_ChunkQuantization::Bits16, filtered);
+
+	int32 compressedSize = FCompression::CompressMemoryBound(NAME_LZ4, filtered.Num());
+	TArray<uint8> compressed;
+	compressed.SetNumUninitialized(compressedSize);
+
+	if (!FCompression::CompressMemory(NAME_LZ4, compressed.GetData(), compressedSize, filtered.GetData(), filtered.Num()) || compressedSize >= data.Num())
+	{
+		return false;
+	}
+
+	compressed.SetNum(compressedSize);
+	compressed.Shrink();
+	data = MoveTemp(compressed);
+	bCompressed = true;
+
+	return true;
+}
+
+bool FFastNoiseQuantizedChunk::Decompress()
+{
+	if (!bCompressed)
+	{
+		return !IsEmpty();
+	}
+
+	TArray<uint8> filtered;
+	filtered.SetNumUninitialized(GetNumBytes());
+
+	if (!FCompression::UncompressMemory(NAME_LZ4, filtered.GetData(), filtered.Num(), data.GetData(), data.Num()))
+	{
+		UE_LOG(LogFastNoiseChunk, Warning, TEXT("Couldn't decompress a chunk of %d bytes"), data.Num());
+		Empty();
+		return false;
+	}
+
+	FastNoiseChunk::DeltaDecode(filtered, quantization == EFastNoise_ChunkQuantization::Bits16, data);
+	bCompressed = false;
+
+	return true;
+}
+
+void FFastNoiseQuantizedChunk::Empty()
+{
+	data.Empty();
+	offset = 0.0f;
+	scale = 0.0f;
+	bCompressed = false;
+}
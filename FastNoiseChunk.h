@@ -0,0 +1,186 @@
+// FastNoiseChunk.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Containers/ArrayView.h"
+#include "FastNoise.h"
+#include "FastNoiseChunk.generated.h"
+
+/** Order of the samples of a cubic 3D chunk */
+UENUM(BlueprintType) enum class EFastNoise_ChunkLayout : uint8 { Linear, Morton, Bricked };
+
+/** Bits per sample of a FFastNoiseQuantizedChunk */
+UENUM(BlueprintType) enum class EFastNoise_ChunkQuantization : uint8 { Bits16, Bits8 };
+
+/**
+ * Sample orders of cubic 3D chunks of size^3 samples, for the meshers reading neighbourhoods of samples.
+ * Linear is the row-major order of the grids, sample (i, j, k) being at index i + (j + k * size) * size.
+ * Morton interleaves the bits of i, j and k (Z-order), so samples close on any axis are close in memory. The size must be a power of two.
+ * Bricked stores the chunk as row-major bricks of BrickSize^3 samples, each brick being row-major. The size must be a multiple of BrickSize
+ */
+class PROJECT_API FFastNoiseChunkLayout
+{
+public:
+
+	/** Size of the bricks of EFastNoise_ChunkLayout::Bricked, 4^3 floats being 4 cache lines */
+	static constexpr int32 BrickSize = 4;
+
+	/** Returns whether chunks of size^3 samples can have a layout */
+	static bool IsSupported(const EFastNoise_ChunkLayout layout, const int32 size);
+
+	/** Returns the index of sample (i, j, k) of a chunk. The index is the sum of one offset per axis, see GetAxisOffsets(...) */
+	static int32 GetIndex(const EFastNoise_ChunkLayout layout, const int32 size, const int32 i, const int32 j, const int32 k)
+	{
+		return GetAxisOffset(layout, size, 0, i) + GetAxisOffset(layout, size, 1, j) + GetAxisOffset(layout, size, 2, k);
+	}
+
+	/** Returns the offset of coordinate i on an axis (0 for X, 1 for Y, 2 for Z) */
+	static int32 GetAxisOffset(const EFastNoise_ChunkLayout layout, const int32 size, const int32 axis, const int32 i)
+	{
+		switch (layout)
+		{
+		case EFastNoise_ChunkLayout::Morton:
+			return int32(SpreadBits(uint32(i)) << axis);
+		case EFastNoise_ChunkLayout::Bricked:
+		{
+			const int32 numBricks = size / BrickSize;
+			const int32 brickStride = axis == 0 ? 1 : (axis == 1 ? numBricks : numBricks * numBricks);
+			const int32 sampleStride = axis == 0 ? 1 : (axis == 1 ? BrickSize : BrickSize * BrickSize);
+			return (i / BrickSize) * brickStride * (BrickSize * BrickSize * BrickSize) + (i % BrickSize) * sampleStride;
+		}
+		default:
+			return axis == 0 ? i : (axis == 1 ? i * size : i * size * size);
+		}
+	}
+
+	/** Returns the offsets of the size coordinates of each axis, so chunks can be walked without computing indices */
+	static void GetAxisOffsets(const EFastNoise_ChunkLayout layout, const int32 size, TArray<int32>& outX, TArray<int32>& outY, TArray<int32>& outZ);
+
+	/**
+	* Generates a chunk in a layout, with the same values as UFastNoiseWrapper::GetNoise3DGrid(...) over size^3 samples
+	*
+	* @param noise		- the noise, e.g. UFastNoiseWrapper::GetSnapshot() or FFastNoiseEvaluator::GetFastNoise()
+	* @param outNoise	- the size^3 values, sample (i, j, k) being at index GetIndex(layout, size, i, j, k)
+	* @return false if the layout doesn't support the size or outNoise is too small, outNoise being left as is
+	*/
+	static bool FillNoise3DChunk(const FastNoise& noise, const FVector& origin, const FVector& step, const int32 size, const EFastNoise_ChunkLayout layout, TArrayView<float> outNoise);
+
+	/** Copies a chunk from a layout to another, returns false if either layout doesn't support the size or a view is too small */
+	static bool Reorder(TArrayView<const float> noise, const EFastNoise_ChunkLayout layout, TArrayView<float> outNoise, const EFastNoise_ChunkLayout outLayout, const int32 size);
+
+private:
+
+	/** Moves bit n of the 10 low bits of v to bit 3n */
+	static uint32 SpreadBits(uint32 v)
+	{
+		v &= 0x000003FF;
+		v = (v | (v << 16)) & 0x030000FF;
+		v = (v | (v << 8)) & 0x0300F00F;
+		v = (v | (v << 4)) & 0x030C30C3;
+		v = (v | (v << 2)) & 0x09249249;
+		return v;
+	}
+};
+
+/**
+ * Cubic 3D chunk stored as 16 or 8 bit levels between the minimum and the maximum of the chunk, 2 or 4 times smaller than floats.
+ * The values read back are within half a level, GetMaxError(), of the quantized ones.
+ * Compress() further shrinks the levels with LZ4 for chunks kept in a cache, reading them needs Decompress() first.
+ * Levels are delta coded in the order of the layout before compression, so Morton and bricked chunks, being coherent on all axes, compress best
+ */
+class PROJECT_API FFastNoiseQuantizedChunk
+{
+public:
+
+	/**
+	* Quantizes a chunk, replacing the previous one
+	*
+	* @param noise			- the size^3 values in the given layout, e.g. from FFastNoiseChunkLayout::FillNoise3DChunk(...)
+	* @param chunkQuantization	- the bits per sample
+	* @return false if the layout doesn't support the size or noise is too small, the chunk being emptied
+	*/
+	bool Quantize(TArrayView<const float> noise, const int32 chunkSize, const EFastNoise_ChunkLayout chunkLayout, const EFastNoise_ChunkQuantization chunkQuantization);
+
+	/** Writes the size^3 dequantized values in the layout of the chunk, returns false if the chunk is empty or outNoise is too small */
+	bool Dequantize(TArrayView<float> outNoise) const;
+
+	/** Compresses the levels, returns whether the chunk is compressed. Chunks that don't shrink are left uncompressed */
+	bool Compress();
+
+	/** Decompresses the levels, returns false if the compressed data is invalid, the chunk being emptied */
+	bool Decompress();
+
+	/** Empties the chunk */
+	void Empty();
+
+	/** Returns the dequantized value of sample (i, j, k). The chunk must be uncompressed */
+	float GetNoise(const int32 i, const int32 j, const int32 k) const
+	{
+		const int32 index = FFastNoiseChunkLayout::GetIndex(layout, size, i, j, k);
+		const uint32 level = quantization == EFastNoise_ChunkQuantization::Bits16 ? reinterpret_cast<const uint16*>(data.GetData())[index] : data[index];
+		return offset + level * scale;
+	}
+
+	bool IsEmpty() const { return data.Num() == 0; }
+	bool IsCompressed() const { return bCompressed; }
+
+	int32 GetSize() const { return size; }
+	EFastNoise_ChunkLayout GetLayout() const { return layout; }
+	EFastNoise_ChunkQuantization GetQuantization() const { return quantization; }
+
+	/** Returns the value of level 0, the minimum of the chunk */
+	float GetOffset() const { return offset; }
+
+	/** Returns the difference between consecutive levels, 0 for uniform chunks */
+	float GetScale() const { return scale; }
+
+	/** Returns the largest difference between a quantized value and its dequantized one */
+	float GetMaxError() const { return scale * 0.5f; }
+
+	/** Returns the levels, compressed or not */
+	TArrayView<const uint8> GetData() const { return data; }
+
+	/** Returns the memory used by the chunk, in bytes */
+	SIZE_T GetAllocatedSize() const { return sizeof(*this) + data.GetAllocatedSize(); }
+
+private:
+
+	int32 GetNumBytes() const { return size * size * size * (quantization == EFastNoise_ChunkQuantization::Bits16 ? 2 : 1); }
+
+	TArray<uint8> data;
+	float offset = 0.0f;
+	float scale = 0.0f;
+	int32 size = 0;
+	EFastNoise_ChunkLayout layout = EFastNoise_ChunkLayout::Linear;
+	EFastNoise_ChunkQuantization quantization = EFastNoise_ChunkQuantization::Bits16;
+	bool bCompressed = false;
+};
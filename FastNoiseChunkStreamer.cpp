@@ -0,0 +1,377 @@
+// FastNoiseChunkStreamer.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseChunkStreamer.h"
+#include "FastNoiseStats.h"
+#include "Async/Async.h"
+#include "Algo/Sort.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFastNoiseChunkStreamer, Log, All);
+
+void UFastNoiseChunkStreamer::SetupChunkStreamer(UFastNoiseWrapper* fastNoiseWrapper, const int32 chunkSize, const float sampleSpacing, const int32 radius, const bool b3D, const int32 poolSize, const int32 maxChunksGenerating, const float prefetchTime, const EFastNoise_ChunkLayout layout)
+{
+	// The tasks write into the pool, it can only be reallocated once they are done
+	WaitForTasks();
+
+	for (int32 slot = 0; slot < slots.Num(); slot++)
+	{
+		if (slots[slot].state == ESlotState::Ready)
+		{
+			OnChunkReleased.Broadcast(slots[slot].chunk);
+		}
+	}
+
+	fastNoise = fastNoiseWrapper;
+	size = FMath::Max(chunkSize, 1);
+	spacing = sampleSpacing > 0.0f ? sampleSpacing : 1.0f;
+	streamRadius = FMath::Max(radius, 0);
+	bVolume = b3D;
+	chunkLayout = bVolume && FFastNoiseChunkLayout::IsSupported(layout, size) ? layout : EFastNoise_ChunkLayout::Linear;
+
+	if (bVolume && chunkLayout != layout)
+	{
+		UE_LOG(LogFastNoiseChunkStreamer, Warning, TEXT("Chunks of %d samples can't have layout %d, they are linear"), size, int32(layout));
+	}
+
+	maxGenerating = maxChunksGenerating > 0 ? maxChunksGenerating : FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	prefetch = FMath::Max(prefetchTime, 0.0f);
+	settingsHash = fastNoise ? fastNoise->GetSettingsHash() : 0;
+
+	// The chunks within the radius and the margin IsChunkNeeded(...) keeps around them
+	const int32 diameter = streamRadius * 2 + 3;
+	const int32 numSlots = poolSize > 0 ? poolSize : (bVolume ? diameter * diameter * diameter : diameter * diameter);
+	const int32 chunkSamples = bVolume ? size * size * size : size * size;
+
+	slots.Empty(numSlots);
+	slots.SetNum(numSlots);
+	freeSlots.Empty(numSlots);
+	chunkSlots.Empty(numSlots);
+	candidates.Empty(numSlots);
+	numGenerating = 0;
+
+	for (int32 slot = numSlots - 1; slot >= 0; slot--)
+	{
+		slots[slot].noise.SetNumUninitialized(chunkSamples);
+		freeSlots.Add(slot);
+	}
+
+	UE_LOG(LogFastNoiseChunkStreamer, Verbose, TEXT("Chunk pool of %d chunks, %.1f MB"), numSlots, double(numSlots) * chunkSamples * sizeof(float) / (1024.0 * 1024.0));
+}
+
+int32 UFastNoiseChunkStreamer::AddTrackedPosition(const FVector position)
+{
+	int32 tracker = trackers.IndexOfByPredicate([](const FTracker& other) { return !other.bActive; });
+
+	if (tracker == INDEX_NONE)
+	{
+		tracker = trackers.AddDefaulted();
+	}
+
+	trackers[tracker] = FTracker();
+	trackers[tracker].position = position;
+	trackers[tracker].lastTickPosition = position;
+	trackers[tracker].bActive = true;
+
+	return tracker;
+}
+
+void UFastNoiseChunkStreamer::SetTrackedPosition(const int32 tracker, const FVector position)
+{
+	if (trackers.IsValidIndex(tracker) && trackers[tracker].bActive)
+	{
+		trackers[tracker].position = position;
+	}
+}
+
+void UFastNoiseChunkStreamer::RemoveTrackedPosition(const int32 tracker)
+{
+	if (trackers.IsValidIndex(tracker))
+	{
+		trackers[tracker].bActive = false;
+	}
+}
+
+FIntVector UFastNoiseChunkStreamer::GetChunkAt(const FVector position) const
+{
+	const float chunkExtent = size * spacing;
+
+	return FIntVector(FMath::FloorToInt(position.X / chunkExtent), FMath::FloorToInt(position.Y / chunkExtent), bVolume ? FMath::FloorToInt(position.Z / chunkExtent) : 0);
+}
+
+FVector UFastNoiseChunkStreamer::GetChunkOrigin(const FIntVector chunk) const
+{
+	const float chunkExtent = size * spacing;
+
+	return FVector(chunk.X * chunkExtent, chunk.Y * chunkExtent, bVolume ? chunk.Z * chunkExtent : 0.0f);
+}
+
+bool UFastNoiseChunkStreamer::CopyChunkNoise(const FIntVector chunk, TArray<float>& outNoise) const
+{
+	const TArrayView<const float> noise = GetChunkNoise(chunk);
+	outNoise = TArray<float>(noise.GetData(), noise.Num());
+
+	return noise.Num() > 0;
+}
+
+TArrayView<const float> UFastNoiseChunkStreamer::GetChunkNoise(const FIntVector& chunk) const
+{
+	const int32* slot = chunkSlots.Find(chunk);
+
+	if (!slot || slots[*slot].state != ESlotState::Ready)
+	{
+		return TArrayView<const float>();
+	}
+
+	return slots[*slot].noise;
+}
+
+void UFastNoiseChunkStreamer::Tick(float DeltaTime)
+{
+	// Chunks of previous settings are released, the ones still generating are released when they finish
+	const uint64 currentSettingsHash = fastNoise->GetSettingsHash();
+
+	if (currentSettingsHash != settingsHash)
+	{
+		settingsHash = currentSettingsHash;
+
+		for (int32 slot = 0; slot < slots.Num(); slot++)
+		{
+			if (slots[slot].state == ESlotState::Ready)
+			{
+				ReleaseSlot(slot);
+			}
+		}
+	}
+
+	for (FTracker& tracker : trackers)
+	{
+		if (tracker.bActive && DeltaTime > 0.0f)
+		{
+			tracker.velocity = (tracker.position - tracker.lastTickPosition) / DeltaTime;
+			tracker.lastTickPosition = tracker.position;
+		}
+	}
+
+	for (int32 slot = 0; slot < slots.Num(); slot++)
+	{
+		FSlot& chunkSlot = slots[slot];
+
+		if (chunkSlot.state == ESlotState::Generating && chunkSlot.task.IsReady())
+		{
+			chunkSlot.task.Reset();
+			numGenerating--;
+
+			if (chunkSlot.settingsHash != settingsHash || !IsChunkNeeded(chunkSlot.chunk, 1))
+			{
+				chunkSlots.Remove(chunkSlot.chunk);
+				chunkSlot.state = ESlotState::Free;
+				freeSlots.Add(slot);
+				continue;
+			}
+
+			chunkSlot.state = ESlotState::Ready;
+			OnChunkReady.Broadcast(chunkSlot.chunk);
+		}
+		else if (chunkSlot.state == ESlotState::Ready && !IsChunkNeeded(chunkSlot.chunk, 1))
+		{
+			ReleaseSlot(slot);
+		}
+	}
+
+	if (!fastNoise->IsInitialized())
+	{
+		return;
+	}
+
+	// Missing chunks are sorted by their distance to where the tracked positions are heading
+	candidates.Reset();
+	const float chunkExtent = size * spacing;
+	const int32 radiusZ = bVolume ? streamRadius : 0;
+
+	for (const FTracker& tracker : trackers)
+	{
+		if (!tracker.bActive)
+		{
+			continue;
+		}
+
+		const FIntVector center = GetChunkAt(tracker.position);
+		FVector predicted = (tracker.position + tracker.velocity * prefetch) / chunkExtent - FVector(0.5f, 0.5f, bVolume ? 0.5f : 0.0f);
+
+		if (!bVolume)
+		{
+			predicted.Z = 0.0f;
+		}
+
+		for (int32 z = -radiusZ; z <= radiusZ; z++)
+		{
+			for (int32 y = -streamRadius; y <= streamRadius; y++)
+			{
+				for (int32 x = -streamRadius; x <= streamRadius; x++)
+				{
+					if (x * x + y * y + z * z > streamRadius * streamRadius)
+					{
+						continue;
+					}
+
+					const FIntVector chunk = center + FIntVector(x, y, z);
+
+					if (!chunkSlots.Contains(chunk))
+					{
+						candidates.Emplace(FVector::DistSquared(FVector(chunk), predicted), chunk);
+					}
+				}
+			}
+		}
+	}
+
+	Algo::Sort(candidates, [](const TPair<float, FIntVector>& a, const TPair<float, FIntVector>& b) { return a.Key < b.Key; });
+
+	for (const TPair<float, FIntVector>& candidate : candidates)
+	{
+		if (numGenerating >= maxGenerating)
+		{
+			break;
+		}
+
+		if (freeSlots.Num() == 0)
+		{
+			UE_LOG(LogFastNoiseChunkStreamer, Verbose, TEXT("Chunk pool of %d chunks is full, chunks are left missing"), slots.Num());
+			break;
+		}
+
+		// Tracked positions close to each other need the same chunks
+		if (!chunkSlots.Contains(candidate.Value))
+		{
+			ScheduleChunk(candidate.Value);
+		}
+	}
+}
+
+void UFastNoiseChunkStreamer::BeginDestroy()
+{
+	WaitForTasks();
+
+	Super::BeginDestroy();
+}
+
+bool UFastNoiseChunkStreamer::IsChunkNeeded(const FIntVector& chunk, const int32 margin) const
+{
+	const int32 radius = streamRadius + margin;
+
+	for (const FTracker& tracker : trackers)
+	{
+		const FIntVector offset = chunk - GetChunkAt(tracker.position);
+
+		if (tracker.bActive && offset.X * offset.X + offset.Y * offset.Y + offset.Z * offset.Z <= radius * radius)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UFastNoiseChunkStreamer::ReleaseSlot(const int32 slot)
+{
+	const FIntVector chunk = slots[slot].chunk;
+
+	chunkSlots.Remove(chunk);
+	slots[slot].state = ESlotState::Free;
+	freeSlots.Add(slot);
+
+	OnChunkReleased.Broadcast(chunk);
+}
+
+void UFastNoiseChunkStreamer::ScheduleChunk(const FIntVector& chunk)
+{
+	const int32 slot = freeSlots.Pop(false);
+	FSlot& chunkSlot = slots[slot];
+
+	chunkSlot.chunk = chunk;
+	chunkSlot.state = ESlotState::Generating;
+	chunkSlot.settingsHash = settingsHash;
+	chunkSlots.Add(chunk, slot);
+	numGenerating++;
+	INC_DWORD_STAT(STAT_FastNoise_NumChunksGenerating);
+
+	// The task only touches its buffer, the pool isn't reallocated until every task is done
+	const TSharedRef<const FastNoise, ESPMode::ThreadSafe> noise = fastNoise->GetSnapshot();
+	float* outNoise = chunkSlot.noise.GetData();
+	const FVector origin = GetChunkOrigin(chunk);
+	const int32 chunkSize = size;
+	const float step = spacing;
+	const bool b3D = bVolume;
+	const EFastNoise_ChunkLayout layout = chunkLayout;
+
+	chunkSlot.task = Async(EAsyncExecution::TaskGraph, [noise, outNoise, origin, chunkSize, step, b3D, layout]()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FastNoise_Chunk);
+		TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_GenerateChunk);
+
+		if (layout != EFastNoise_ChunkLayout::Linear)
+		{
+			FFastNoiseChunkLayout::FillNoise3DChunk(*noise, origin, FVector(step), chunkSize, layout, TArrayView<float>(outNoise, chunkSize * chunkSize * chunkSize));
+			DEC_DWORD_STAT(STAT_FastNoise_NumChunksGenerating);
+			return;
+		}
+
+		// One row at a time, like UFastNoiseWrapper::GetNoise2DGrid/GetNoise3DGrid(...)
+		const int32 numRows = b3D ? chunkSize * chunkSize : chunkSize;
+		FastNoiseStats::AddSamples(noise->GetNoiseType(), int64(numRows) * chunkSize);
+
+		for (int32 row = 0; row < numRows; row++)
+		{
+			const int32 j = row % chunkSize;
+			const int32 k = row / chunkSize;
+
+			if (b3D)
+			{
+				noise->FillNoiseSet3D(outNoise + row * chunkSize, origin.X, origin.Y + j * step, origin.Z + k * step, chunkSize, 1, 1, step, step, step);
+			}
+			else
+			{
+				noise->FillNoiseSet2D(outNoise + row * chunkSize, origin.X, origin.Y + j * step, chunkSize, 1, step, step);
+			}
+		}
+
+		DEC_DWORD_STAT(STAT_FastNoise_NumChunksGenerating);
+	});
+}
+
+void UFastNoiseChunkStreamer::WaitForTasks()
+{
+	for (FSlot& chunkSlot : slots)
+	{
+		if (chunkSlot.task.IsValid())
+		{
+			chunkSlot.task.Wait();
+		}
+	}
+}
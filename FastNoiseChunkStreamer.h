@@ -0,0 +1,190 @@
+// FastNoiseChunkStreamer.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Tickable.h"
+#include "Containers/ArrayView.h"
+#include "FastNoiseWrapper.h"
+#include "FastNoiseBufferPool.h"
+#include "FastNoiseChunk.h"
+#include "FastNoiseChunkStreamer.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FFastNoiseChunkEvent, FIntVector, chunk);
+
+/**
+ * Streams chunks of noise around one or more tracked positions, e.g. the players of an open world.
+ * Every tick, the missing chunks within the radius of a tracked position are generated on the task graph, closest to where
+ * the position is heading first, and the chunks left behind are released. Chunks are stored in a pool of buffers allocated
+ * by SetupChunkStreamer(...), so streaming doesn't allocate noise memory once set up.
+ * Chunk (x, y, z) holds the same values as GetNoise2DGrid/GetNoise3DGrid(...) of the wrapper at GetChunkOrigin(...), in the order of GetChunkLayout()
+ */
+UCLASS(BlueprintType)
+class PROJECT_API UFastNoiseChunkStreamer : public UObject, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Called on the game thread when a chunk is generated, its values can be read until OnChunkReleased is called for it */
+	UPROPERTY(BlueprintAssignable)
+	FFastNoiseChunkEvent OnChunkReady;
+
+	/** Called on the game thread when a chunk left the radius of every tracked position or the noise settings changed */
+	UPROPERTY(BlueprintAssignable)
+	FFastNoiseChunkEvent OnChunkReleased;
+
+	/**
+	* Set the streamer properties, releasing every chunk and allocating the pool. The tracked positions are kept
+	*
+	* @param fastNoiseWrapper		- the noise settings, chunks are generated again when they change
+	* @param chunkSize				- number of samples on each axis of a chunk. Default value: 64
+	* @param sampleSpacing			- distance between two samples on each axis. Default value: 1.0
+	* @param radius					- chunks whose distance to a tracked chunk is at most radius chunks are streamed in. Default value: 4
+	* @param b3D					- whether the chunks are 3D volumes instead of 2D grids. Default value: false
+	* @param poolSize				- number of chunk buffers, 0 for the chunks around one tracked position. Default value: 0
+	* @param maxChunksGenerating	- number of chunks generated at the same time, 0 for the number of worker threads. Default value: 0
+	* @param prefetchTime			- missing chunks are prioritized by their distance to where the tracked position will be in prefetchTime seconds. Default value: 0.5
+	* @param layout					- order of the samples of 3D chunks, linear if it doesn't support chunkSize. 2D chunks are always linear. Default value: Linear
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Chunk streamer")
+	void SetupChunkStreamer(UFastNoiseWrapper* fastNoiseWrapper, const int32 chunkSize = 64, const float sampleSpacing = 1.0f, const int32 radius = 4, const bool b3D = false, const int32 poolSize = 0, const int32 maxChunksGenerating = 0, const float prefetchTime = 0.5f, const EFastNoise_ChunkLayout layout = EFastNoise_ChunkLayout::Linear);
+
+	/** Adds a position chunks are streamed around, returns its index */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Chunk streamer")
+	int32 AddTrackedPosition(const FVector position);
+
+	/** Moves a tracked position, its velocity is estimated from one tick to the next */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Chunk streamer")
+	void SetTrackedPosition(const int32 tracker, const FVector position);
+
+	/** Stops streaming around a tracked position, its chunks are released once no other tracked position needs them */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Chunk streamer")
+	void RemoveTrackedPosition(const int32 tracker);
+
+	/** Returns the chunk containing a position */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Chunk streamer")
+	FIntVector GetChunkAt(const FVector position) const;
+
+	/** Returns the position of the first sample of a chunk */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Chunk streamer")
+	FVector GetChunkOrigin(const FIntVector chunk) const;
+
+	/** Returns whether a chunk is generated */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Chunk streamer")
+	bool IsChunkReady(const FIntVector chunk) const { return GetChunkNoise(chunk).Num() > 0; }
+
+	/**
+	* Copies the values of a generated chunk
+	*
+	* @param chunk		- the chunk coordinate
+	* @param outNoise	- the chunkSize^2 (2D) or chunkSize^3 (3D) values, sample (i, j, k) being at index FFastNoiseChunkLayout::GetIndex(GetChunkLayout(), chunkSize, i, j, k)
+	* @return whether the chunk is generated
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Chunk streamer")
+	bool CopyChunkNoise(const FIntVector chunk, TArray<float>& outNoise) const;
+
+	/** Returns the values of a generated chunk, laid out like CopyChunkNoise(...), empty if it isn't. Valid until the chunk is released */
+	TArrayView<const float> GetChunkNoise(const FIntVector& chunk) const;
+
+	/** Returns the order of the samples of the chunks */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Chunk streamer")
+	EFastNoise_ChunkLayout GetChunkLayout() const { return chunkLayout; }
+
+	/** Returns the number of chunks generated and not released */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Chunk streamer")
+	int32 GetNumChunksReady() const { return chunkSlots.Num() - GetNumChunksGenerating(); }
+
+	/** Returns the number of chunks being generated */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Chunk streamer")
+	int32 GetNumChunksGenerating() const { return numGenerating; }
+
+	/** Returns the number of chunk buffers */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Chunk streamer")
+	int32 GetPoolSize() const { return slots.Num(); }
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return fastNoise != nullptr && slots.Num() > 0; }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UFastNoiseChunkStreamer, STATGROUP_Tickables); }
+
+	// UObject interface
+	virtual void BeginDestroy() override;
+
+private:
+
+	enum class ESlotState : uint8 { Free, Generating, Ready };
+
+	/** Buffer of the pool, allocated once by SetupChunkStreamer(...) */
+	struct FSlot
+	{
+		FFastNoiseAlignedArray noise;
+		FIntVector chunk = FIntVector::ZeroValue;
+		ESlotState state = ESlotState::Free;
+		/** Settings the chunk is generated with, chunks of previous settings are released */
+		uint64 settingsHash = 0;
+		TFuture<void> task;
+	};
+
+	struct FTracker
+	{
+		FVector position = FVector::ZeroVector;
+		FVector lastTickPosition = FVector::ZeroVector;
+		FVector velocity = FVector::ZeroVector;
+		bool bActive = false;
+	};
+
+	/** Whether a chunk is within the radius of a tracked position, plus an extra margin so chunks on the edge don't flicker in and out */
+	bool IsChunkNeeded(const FIntVector& chunk, const int32 margin) const;
+	void ReleaseSlot(const int32 slot);
+	void ScheduleChunk(const FIntVector& chunk);
+	void WaitForTasks();
+
+	UPROPERTY()
+	UFastNoiseWrapper* fastNoise = nullptr;
+
+	TArray<FSlot> slots;
+	TArray<int32> freeSlots;
+	TMap<FIntVector, int32> chunkSlots;
+	TArray<FTracker> trackers;
+	/** Missing chunks and their priority, kept between ticks so the scheduling doesn't allocate */
+	TArray<TPair<float, FIntVector>> candidates;
+
+	int32 size = 64;
+	float spacing = 1.0f;
+	int32 streamRadius = 4;
+	bool bVolume = false;
+	EFastNoise_ChunkLayout chunkLayout = EFastNoise_ChunkLayout::Linear;
+	int32 maxGenerating = 4;
+	float prefetch = 0.5f;
+	int32 numGenerating = 0;
+	uint64 settingsHash = 0;
+};
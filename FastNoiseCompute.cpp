@@ -0,0 +1,290 @@
+// FastNoiseCompute.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseCompute.h"
+#include "FastNoiseStats.h"
+#include "GlobalShader.h"
+#include "ShaderParameterStruct.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderingThread.h"
+#include "RHIGPUReadback.h"
+
+class FFastNoiseComputeCS : public FGlobalShader
+{
+public:
+
+	DECLARE_GLOBAL_SHADER(FFastNoiseComputeCS);
+	SHADER_USE_PARAMETER_STRUCT(FFastNoiseComputeCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, Perm)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, Perm12)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, GradX)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, GradY)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, GradZ)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, ValLut)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Cell2DX)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Cell2DY)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Cell3DX)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Cell3DY)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Cell3DZ)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, OutNoise)
+		SHADER_PARAMETER(FVector, Origin)
+		SHADER_PARAMETER(FVector, Step)
+		SHADER_PARAMETER(uint32, SizeX)
+		SHADER_PARAMETER(uint32, SizeY)
+		SHADER_PARAMETER(uint32, SizeZ)
+		SHADER_PARAMETER(uint32, bIs3D)
+		SHADER_PARAMETER(uint32, DispatchWidth)
+		SHADER_PARAMETER(int32, Seed)
+		SHADER_PARAMETER(int32, IndexMode)
+		SHADER_PARAMETER(float, Frequency)
+		SHADER_PARAMETER(int32, NoiseType)
+		SHADER_PARAMETER(int32, Interp)
+		SHADER_PARAMETER(int32, FractalType)
+		SHADER_PARAMETER(int32, Octaves)
+		SHADER_PARAMETER(float, Lacunarity)
+		SHADER_PARAMETER(float, Gain)
+		SHADER_PARAMETER(float, FractalBounding)
+		SHADER_PARAMETER(int32, CellularDistanceFunction)
+		SHADER_PARAMETER(int32, CellularReturnType)
+		SHADER_PARAMETER(float, CellularJitter)
+		SHADER_PARAMETER(int32, CellularDistanceIndex0)
+		SHADER_PARAMETER(int32, CellularDistanceIndex1)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& parameters)
+	{
+		return IsFeatureLevelSupported(parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& parameters, FShaderCompilerEnvironment& outEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(parameters, outEnvironment);
+		outEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), FFastNoiseCompute::ThreadGroupSize);
+	}
+};
+
+IMPLEMENT_GLOBAL_SHADER(FFastNoiseComputeCS, "/FastNoise/FastNoise.usf", "MainCS", SF_Compute);
+
+namespace FastNoiseCompute
+{
+	/** Everything the shader reads from FastNoise, copied on the calling thread so the render thread never touches the FastNoise */
+	struct FSettings
+	{
+		TArray<uint32> perm;
+		TArray<uint32> perm12;
+		FVector origin;
+		FVector step;
+		int32 sizeX, sizeY, sizeZ;
+		bool b3D;
+		int32 seed;
+		int32 indexMode;
+		float frequency;
+		int32 noiseType, interp, fractalType, octaves;
+		float lacunarity, gain, fractalBounding;
+		int32 cellularDistanceFunction, cellularReturnType;
+		float cellularJitter;
+		int32 cellularDistanceIndex0, cellularDistanceIndex1;
+	};
+
+	static FRDGBufferSRVRef CreateTable(FRDGBuilder& graphBuilder, const TCHAR* name, const FN_DECIMAL* table, const int32 num)
+	{
+		// FN_DECIMAL may be double, the shader only works with floats
+		TArray<float> values;
+		values.SetNumUninitialized(num);
+
+		for (int32 i = 0; i < num; i++)
+		{
+			values[i] = float(table[i]);
+		}
+
+		return graphBuilder.CreateSRV(CreateStructuredBuffer(graphBuilder, name, sizeof(float), num, values.GetData(), num * sizeof(float)));
+	}
+
+	static FRDGBufferSRVRef CreateTable(FRDGBuilder& graphBuilder, const TCHAR* name, const TArray<uint32>& table)
+	{
+		return graphBuilder.CreateSRV(CreateStructuredBuffer(graphBuilder, name, sizeof(uint32), table.Num(), table.GetData(), table.Num() * sizeof(uint32)));
+	}
+
+	static TArray<float> Generate_RenderThread(FRHICommandListImmediate& RHICmdList, const FSettings& settings)
+	{
+		const int32 numSamples = settings.sizeX * settings.sizeY * settings.sizeZ;
+		const FastNoise::LookupTables& tables = FastNoise::GetLookupTables();
+
+		FRDGBuilder graphBuilder(RHICmdList);
+		FFastNoiseComputeCS::FParameters* parameters = graphBuilder.AllocParameters<FFastNoiseComputeCS::FParameters>();
+
+		parameters->Perm = CreateTable(graphBuilder, TEXT("FastNoise.Perm"), settings.perm);
+		parameters->Perm12 = CreateTable(graphBuilder, TEXT("FastNoise.Perm12"), settings.perm12);
+		parameters->GradX = CreateTable(graphBuilder, TEXT("FastNoise.GradX"), tables.gradX, 12);
+		parameters->GradY = CreateTable(graphBuilder, TEXT("FastNoise.GradY"), tables.gradY, 12);
+		parameters->GradZ = CreateTable(graphBuilder, TEXT("FastNoise.GradZ"), tables.gradZ, 12);
+		parameters->ValLut = CreateTable(graphBuilder, TEXT("FastNoise.ValLut"), tables.valLut, 256);
+		parameters->Cell2DX = CreateTable(graphBuilder, TEXT("FastNoise.Cell2DX"), tables.cell2DX, 256);
+		parameters->Cell2DY = CreateTable(graphBuilder, TEXT("FastNoise.Cell2DY"), tables.cell2DY, 256);
+		parameters->Cell3DX = CreateTable(graphBuilder, TEXT("FastNoise.Cell3DX"), tables.cell3DX, 256);
+		parameters->Cell3DY = CreateTable(graphBuilder, TEXT("FastNoise.Cell3DY"), tables.cell3DY, 256);
+		parameters->Cell3DZ = CreateTable(graphBuilder, TEXT("FastNoise.Cell3DZ"), tables.cell3DZ, 256);
+
+		FRDGBufferRef output = graphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(sizeof(float), numSamples), TEXT("FastNoise.Output"));
+		parameters->OutNoise = graphBuilder.CreateUAV(output);
+
+		parameters->Origin = settings.origin;
+		parameters->Step = settings.step;
+		parameters->SizeX = settings.sizeX;
+		parameters->SizeY = settings.sizeY;
+		parameters->SizeZ = settings.sizeZ;
+		parameters->bIs3D = settings.b3D;
+		parameters->Seed = settings.seed;
+		parameters->IndexMode = settings.indexMode;
+		parameters->Frequency = settings.frequency;
+		parameters->NoiseType = settings.noiseType;
+		parameters->Interp = settings.interp;
+		parameters->FractalType = settings.fractalType;
+		parameters->Octaves = settings.octaves;
+		parameters->Lacunarity = settings.lacunarity;
+		parameters->Gain = settings.gain;
+		parameters->FractalBounding = settings.fractalBounding;
+		parameters->CellularDistanceFunction = settings.cellularDistanceFunction;
+		parameters->CellularReturnType = settings.cellularReturnType;
+		parameters->CellularJitter = settings.cellularJitter;
+		parameters->CellularDistanceIndex0 = settings.cellularDistanceIndex0;
+		parameters->CellularDistanceIndex1 = settings.cellularDistanceIndex1;
+
+		// Groups are laid out in rows of at most 65535, the maximum dispatch size on each axis
+		const int32 numGroups = FMath::DivideAndRoundUp(numSamples, FFastNoiseCompute::ThreadGroupSize);
+		const FIntVector groupCount(FMath::Min(numGroups, 65535), FMath::DivideAndRoundUp(numGroups, 65535), 1);
+		parameters->DispatchWidth = groupCount.X * FFastNoiseCompute::ThreadGroupSize;
+
+		TShaderMapRef<FFastNoiseComputeCS> shader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+		FComputeShaderUtils::AddPass(graphBuilder, RDG_EVENT_NAME("FastNoise %dx%dx%d", settings.sizeX, settings.sizeY, settings.sizeZ), shader, parameters, groupCount);
+
+		FRHIGPUBufferReadback readback(TEXT("FastNoise.Readback"));
+		AddEnqueueCopyPass(graphBuilder, &readback, output, numSamples * sizeof(float));
+
+		graphBuilder.Execute();
+
+		// Large grids are requested by imports and tools waiting for the result, so waiting here beats polling the readback over the next frames
+		RHICmdList.SubmitCommandsAndFlushGPU();
+		RHICmdList.BlockUntilGPUIdle();
+
+		TArray<float> outNoise;
+		outNoise.SetNumUninitialized(numSamples);
+		FMemory::Memcpy(outNoise.GetData(), readback.Lock(numSamples * sizeof(float)), numSamples * sizeof(float));
+		readback.Unlock();
+
+		return outNoise;
+	}
+}
+
+bool FFastNoiseCompute::IsSupported(const FastNoise& noise)
+{
+	if (GMaxRHIFeatureLevel < ERHIFeatureLevel::SM5)
+	{
+		return false;
+	}
+
+	switch (noise.GetNoiseType())
+	{
+	case FastNoise::WhiteNoise:
+		return false;
+	case FastNoise::Cellular:
+		return noise.GetCellularReturnType() != FastNoise::NoiseLookup;
+	default:
+		return true;
+	}
+}
+
+void FFastNoiseCompute::GetPermutationTables(const FastNoise& noise, TArray<uint32>& outPerm, TArray<uint32>& outPerm12)
+{
+	const unsigned char* perm = noise.GetPermutation();
+	const unsigned char* perm12 = noise.GetPermutation12();
+
+	outPerm.SetNumUninitialized(512);
+	outPerm12.SetNumUninitialized(512);
+
+	for (int32 i = 0; i < 512; i++)
+	{
+		outPerm[i] = perm[i];
+		outPerm12[i] = perm12[i];
+	}
+}
+
+TFuture<TArray<float>> FFastNoiseCompute::GenerateAsync(const FastNoise& noise, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D)
+{
+	using namespace FastNoiseCompute;
+
+	TSharedRef<TPromise<TArray<float>>, ESPMode::ThreadSafe> promise = MakeShared<TPromise<TArray<float>>, ESPMode::ThreadSafe>();
+	TFuture<TArray<float>> future = promise->GetFuture();
+
+	if (sizeX <= 0 || sizeY <= 0 || sizeZ <= 0)
+	{
+		promise->SetValue(TArray<float>());
+		return future;
+	}
+
+	FSettings settings;
+	GetPermutationTables(noise, settings.perm, settings.perm12);
+	settings.origin = origin;
+	settings.step = step;
+	settings.sizeX = sizeX;
+	settings.sizeY = sizeY;
+	settings.sizeZ = sizeZ;
+	settings.b3D = b3D;
+	settings.seed = noise.GetSeed();
+	settings.indexMode = noise.GetIndexMode();
+	settings.frequency = noise.GetFrequency();
+	settings.noiseType = noise.GetNoiseType();
+	settings.interp = noise.GetInterp();
+	settings.fractalType = noise.GetFractalType();
+	// The shader loops over the octaves left by the amplitude threshold, the fractal bounding still covers all of them
+	settings.octaves = noise.GetFractalOctavesEvaluated();
+	settings.lacunarity = noise.GetFractalLacunarity();
+	settings.gain = noise.GetFractalGain();
+	settings.fractalBounding = noise.GetFractalBounding();
+	settings.cellularDistanceFunction = noise.GetCellularDistanceFunction();
+	settings.cellularReturnType = noise.GetCellularReturnType();
+	settings.cellularJitter = noise.GetCellularJitter();
+	noise.GetCellularDistance2Indices(settings.cellularDistanceIndex0, settings.cellularDistanceIndex1);
+
+	INC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+	FastNoiseStats::AddSamples(noise.GetNoiseType(), int64(sizeX) * sizeY * sizeZ);
+
+	ENQUEUE_RENDER_COMMAND(FastNoiseCompute)([settings, promise](FRHICommandListImmediate& RHICmdList)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FastNoiseCompute_Generate);
+
+		promise->SetValue(Generate_RenderThread(RHICmdList, settings));
+		DEC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+	});
+
+	return future;
+}
@@ -0,0 +1,68 @@
+// FastNoiseCompute.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "FastNoise.h"
+
+/**
+ * Compute shader backend generating noise grids on the GPU, see Shaders/FastNoise.usf.
+ * The shader mirrors FastNoise.cpp and reads the same tables, so it matches FillNoiseSet2D/3D(...) within floating point tolerance.
+ * The project module must map the shader directory with AddShaderSourceDirectoryMapping(TEXT("/FastNoise"), ...) on startup
+ */
+class PROJECT_API FFastNoiseCompute
+{
+public:
+
+	/** Returns whether the GPU can generate this noise, White Noise and the NoiseLookup cellular return type are CPU only */
+	static bool IsSupported(const FastNoise& noise);
+
+	/**
+	* Generates the same grid as FillNoiseSet2D/3D(...) on the GPU. The settings are copied when the function is called,
+	* the future is set from the render thread once the GPU is done
+	*
+	* @param noise	- the noise settings
+	* @param origin	- the x, y and z values of the first sample
+	* @param step	- the distance between two consecutive samples on each axis
+	* @param sizeX	- the number of samples along x
+	* @param sizeY	- the number of samples along y
+	* @param sizeZ	- the number of samples along z, 1 for 2D grids
+	* @param b3D	- whether to sample 3D noise, z being ignored otherwise
+	* @return a future holding the sizeX * sizeY * sizeZ noise values, sample (i, j, k) being at index i + (j + k * sizeY) * sizeX
+	*/
+	static TFuture<TArray<float>> GenerateAsync(const FastNoise& noise, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D);
+
+	/** Copies the 512 entry permutation tables of the seed widened to the uint32 the shaders read */
+	static void GetPermutationTables(const FastNoise& noise, TArray<uint32>& outPerm, TArray<uint32>& outPerm12);
+
+	/** Threads per group of the compute shader */
+	static constexpr int32 ThreadGroupSize = 64;
+};
@@ -0,0 +1,213 @@
+// FastNoiseDiskCache.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseDiskCache.h"
+#include "FastNoiseStats.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFastNoiseDiskCache, Log, All);
+
+namespace FastNoiseDiskCache
+{
+	static constexpr uint32 Magic = 0x43544E46; // "FNTC"
+}
+
+FFastNoiseMappedGrid::~FFastNoiseMappedGrid()
+{
+	// The region has to be unmapped before the file is closed
+	region.Reset();
+	file.Reset();
+}
+
+FString FFastNoiseDiskCache::GetCacheDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectDir(), TEXT("DerivedDataCache"), TEXT("FastNoise"));
+}
+
+bool FFastNoiseDiskCache::GetNoise2DGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector2D& origin, const FVector2D& step, const int32 sizeX, const int32 sizeY, TArray<float>& outNoise)
+{
+	return GetNoiseGrid(fastNoiseWrapper, FVector(origin.X, origin.Y, 0.0f), FVector(step.X, step.Y, 0.0f), sizeX, sizeY, 1, false, outNoise);
+}
+
+bool FFastNoiseDiskCache::GetNoise3DGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArray<float>& outNoise)
+{
+	return GetNoiseGrid(fastNoiseWrapper, origin, step, sizeX, sizeY, sizeZ, true, outNoise);
+}
+
+TUniquePtr<FFastNoiseMappedGrid> FFastNoiseDiskCache::MapNoise2DGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector2D& origin, const FVector2D& step, const int32 sizeX, const int32 sizeY)
+{
+	if (!fastNoiseWrapper || !fastNoiseWrapper->IsInitialized())
+	{
+		return nullptr;
+	}
+
+	return Map(MakeHeader(fastNoiseWrapper, FVector(origin.X, origin.Y, 0.0f), FVector(step.X, step.Y, 0.0f), sizeX, sizeY, 1, false));
+}
+
+TUniquePtr<FFastNoiseMappedGrid> FFastNoiseDiskCache::MapNoise3DGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ)
+{
+	if (!fastNoiseWrapper || !fastNoiseWrapper->IsInitialized())
+	{
+		return nullptr;
+	}
+
+	return Map(MakeHeader(fastNoiseWrapper, origin, step, sizeX, sizeY, sizeZ, true));
+}
+
+void FFastNoiseDiskCache::Empty()
+{
+	IFileManager::Get().DeleteDirectory(*GetCacheDirectory(), false, true);
+}
+
+FFastNoiseDiskCache::FHeader FFastNoiseDiskCache::MakeHeader(UFastNoiseWrapper* fastNoiseWrapper, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D)
+{
+	static_assert(sizeof(FHeader) == 64, "The cached values must start 64 bytes in");
+
+	// Zeroed first so the padding doesn't change the file name
+	FHeader header;
+	FMemory::Memzero(header);
+	header.magic = FastNoiseDiskCache::Magic;
+	header.version = Version;
+	header.settingsHash = fastNoiseWrapper->GetSettingsHash();
+	header.origin[0] = origin.X;
+	header.origin[1] = origin.Y;
+	header.origin[2] = b3D ? origin.Z : 0.0f;
+	header.step[0] = step.X;
+	header.step[1] = step.Y;
+	header.step[2] = b3D ? step.Z : 0.0f;
+	header.size[0] = FMath::Max(sizeX, 0);
+	header.size[1] = FMath::Max(sizeY, 0);
+	header.size[2] = b3D ? FMath::Max(sizeZ, 0) : 1;
+	header.b3D = b3D;
+
+	return header;
+}
+
+FString FFastNoiseDiskCache::GetFilename(const FHeader& header)
+{
+	const uint64 key = CityHash64(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	return FPaths::Combine(GetCacheDirectory(), FString::Printf(TEXT("%016llx.fnt"), key));
+}
+
+TUniquePtr<FFastNoiseMappedGrid> FFastNoiseDiskCache::Map(const FHeader& header)
+{
+	const int64 numSamples = int64(header.size[0]) * header.size[1] * header.size[2];
+	const int64 fileSize = sizeof(FHeader) + numSamples * sizeof(float);
+	const FString filename = GetFilename(header);
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoiseDiskCache_Map);
+
+	if (numSamples == 0 || IFileManager::Get().FileSize(*filename) != fileSize)
+	{
+		INC_DWORD_STAT(STAT_FastNoise_DiskCacheMisses);
+		return nullptr;
+	}
+
+	TUniquePtr<FFastNoiseMappedGrid> grid = MakeUnique<FFastNoiseMappedGrid>();
+	grid->file.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*filename));
+
+	if (grid->file.IsValid())
+	{
+		grid->region.Reset(grid->file->MapRegion(0, fileSize));
+	}
+
+	if (!grid->region.IsValid())
+	{
+		UE_LOG(LogFastNoiseDiskCache, Warning, TEXT("Couldn't map %s"), *filename);
+		INC_DWORD_STAT(STAT_FastNoise_DiskCacheMisses);
+		return nullptr;
+	}
+
+	// Different grids hashing to the same file name are told apart by the header
+	if (FMemory::Memcmp(grid->region->GetMappedPtr(), &header, sizeof(FHeader)) != 0)
+	{
+		INC_DWORD_STAT(STAT_FastNoise_DiskCacheMisses);
+		return nullptr;
+	}
+
+	INC_DWORD_STAT(STAT_FastNoise_DiskCacheHits);
+
+	grid->noise = TArrayView<const float>(reinterpret_cast<const float*>(grid->region->GetMappedPtr() + sizeof(FHeader)), int32(numSamples));
+
+	return grid;
+}
+
+bool FFastNoiseDiskCache::GetNoiseGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D, TArray<float>& outNoise)
+{
+	const int32 numSamples = FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * (b3D ? FMath::Max(sizeZ, 0) : 1);
+	outNoise.SetNumUninitialized(numSamples);
+
+	if (!fastNoiseWrapper || !fastNoiseWrapper->IsInitialized() || numSamples == 0)
+	{
+		FMemory::Memzero(outNoise.GetData(), numSamples * sizeof(float));
+		return false;
+	}
+
+	const FHeader header = MakeHeader(fastNoiseWrapper, origin, step, sizeX, sizeY, sizeZ, b3D);
+
+	if (TUniquePtr<FFastNoiseMappedGrid> grid = Map(header))
+	{
+		FMemory::Memcpy(outNoise.GetData(), grid->GetNoise().GetData(), numSamples * sizeof(float));
+		return true;
+	}
+
+	if (b3D)
+	{
+		fastNoiseWrapper->FillNoise3DGrid(origin, step, sizeX, sizeY, sizeZ, outNoise);
+	}
+	else
+	{
+		fastNoiseWrapper->FillNoise2DGrid(FVector2D(origin.X, origin.Y), FVector2D(step.X, step.Y), sizeX, sizeY, outNoise);
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoiseDiskCache_Write);
+
+	TArray<uint8> file;
+	file.SetNumUninitialized(sizeof(FHeader) + numSamples * sizeof(float));
+	FMemory::Memcpy(file.GetData(), &header, sizeof(FHeader));
+	FMemory::Memcpy(file.GetData() + sizeof(FHeader), outNoise.GetData(), numSamples * sizeof(float));
+
+	// Written under a temporary name then moved, so other processes sharing the cache never map a partial file
+	const FString filename = GetFilename(header);
+	const FString tempFilename = filename + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+
+	if (!FFileHelper::SaveArrayToFile(file, *tempFilename) || !IFileManager::Get().Move(*filename, *tempFilename, true, true))
+	{
+		UE_LOG(LogFastNoiseDiskCache, Warning, TEXT("Couldn't write %s"), *filename);
+		IFileManager::Get().Delete(*tempFilename, false, false, true);
+	}
+
+	return false;
+}
@@ -0,0 +1,124 @@
+// FastNoiseDiskCache.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Templates/UniquePtr.h"
+#include "FastNoiseWrapper.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Grid of noise values memory mapped from the disk cache, see FFastNoiseDiskCache::MapNoise2DGrid(...).
+ * The values are read straight from the file until the grid is destroyed
+ */
+class PROJECT_API FFastNoiseMappedGrid
+{
+public:
+
+	~FFastNoiseMappedGrid();
+
+	/** Returns the values, sample (i, j, k) being at index i + (j + k * sizeY) * sizeX */
+	TArrayView<const float> GetNoise() const { return noise; }
+
+private:
+
+	friend class FFastNoiseDiskCache;
+
+	TUniquePtr<IMappedFileHandle> file;
+	TUniquePtr<IMappedFileRegion> region;
+	TArrayView<const float> noise;
+};
+
+/**
+ * Opt-in cache of generated grids on disk under DerivedDataCache/FastNoise, for the editor and the cook generating the same
+ * heightfields every time a level is opened or cooked. Grids are keyed by the settings hash of the wrapper and their bounds,
+ * each one is stored in its own file with a header checked on every read, and read back through memory mapping.
+ * Cached grids hold the same values as GetNoise2DGrid/GetNoise3DGrid(...)
+ */
+class PROJECT_API FFastNoiseDiskCache
+{
+public:
+
+	/** Version of the file format, files of other versions are ignored. Bump it when the noise values of the same settings change */
+	static constexpr uint32 Version = 1;
+
+	/** Returns the directory of the cached grids */
+	static FString GetCacheDirectory();
+
+	/**
+	* Returns the same values as GetNoise2DGrid(...), reading them from the disk cache or generating and caching them
+	*
+	* @param fastNoiseWrapper	- the noise settings, grids of uninitialized wrappers are neither read nor cached
+	* @param outNoise			- the sizeX * sizeY noise values, sample (i, j) being at index i + j * sizeX
+	* @return whether the values were read from the cache
+	*/
+	static bool GetNoise2DGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector2D& origin, const FVector2D& step, const int32 sizeX, const int32 sizeY, TArray<float>& outNoise);
+
+	/**
+	* Returns the same values as GetNoise3DGrid(...), reading them from the disk cache or generating and caching them
+	*
+	* @param fastNoiseWrapper	- the noise settings, grids of uninitialized wrappers are neither read nor cached
+	* @param outNoise			- the sizeX * sizeY * sizeZ noise values, sample (i, j, k) being at index i + (j + k * sizeY) * sizeX
+	* @return whether the values were read from the cache
+	*/
+	static bool GetNoise3DGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArray<float>& outNoise);
+
+	/** Memory maps a cached 2D grid without copying it, null if it isn't cached */
+	static TUniquePtr<FFastNoiseMappedGrid> MapNoise2DGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector2D& origin, const FVector2D& step, const int32 sizeX, const int32 sizeY);
+
+	/** Memory maps a cached 3D grid without copying it, null if it isn't cached */
+	static TUniquePtr<FFastNoiseMappedGrid> MapNoise3DGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ);
+
+	/** Deletes every cached grid */
+	static void Empty();
+
+private:
+
+	/** File header, padded to 64 bytes so the mapped values are aligned like a FFastNoiseBuffer */
+	struct FHeader
+	{
+		uint32 magic;
+		uint32 version;
+		uint64 settingsHash;
+		float origin[3];
+		float step[3];
+		int32 size[3];
+		uint32 b3D;
+		uint8 padding[8];
+	};
+
+	static FHeader MakeHeader(UFastNoiseWrapper* fastNoiseWrapper, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D);
+	static FString GetFilename(const FHeader& header);
+	static TUniquePtr<FFastNoiseMappedGrid> Map(const FHeader& header);
+	static bool GetNoiseGrid(UFastNoiseWrapper* fastNoiseWrapper, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D, TArray<float>& outNoise);
+};
@@ -0,0 +1,513 @@
+// FastNoiseGraph.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseGraph.h"
+#include "FastNoiseStats.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFastNoiseGraph, Log, All);
+
+struct FFastNoiseGraphProgram::FCompileContext
+{
+	explicit FCompileContext(const TArray<FFastNoiseGraphNode>& inNodes) : nodes(inNodes)
+	{
+		visiting.Init(false, nodes.Num());
+	}
+
+	const TArray<FFastNoiseGraphNode>& nodes;
+	/** Instruction computing each node evaluated with each position set, so shared nodes are only evaluated once */
+	TMap<TPair<int32, int32>, int32> values;
+	/** Nodes on the current compilation path, a node reached again from itself is part of a cycle */
+	TArray<bool> visiting;
+	/** Set by the first error, so it is the only one logged */
+	bool bFailed = false;
+};
+
+TSharedPtr<const FFastNoiseGraphProgram, ESPMode::ThreadSafe> FFastNoiseGraphProgram::Compile(const TArray<FFastNoiseGraphNode>& nodes, const int32 outputNode)
+{
+	if (nodes.Num() == 0)
+	{
+		UE_LOG(LogFastNoiseGraph, Warning, TEXT("Can't compile a noise graph without nodes"));
+		return nullptr;
+	}
+
+	TSharedRef<FFastNoiseGraphProgram, ESPMode::ThreadSafe> program = MakeShared<FFastNoiseGraphProgram, ESPMode::ThreadSafe>();
+	FCompileContext context(nodes);
+
+	const int32 outputValue = program->CompileNode(context, outputNode, 0);
+
+	if (outputValue == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	program->AllocateRegisters(outputValue);
+
+	UE_LOG(LogFastNoiseGraph, Verbose, TEXT("Compiled %d nodes into %d instructions, %d registers and %d position sets"), nodes.Num(), program->instructions.Num(), program->numRegisters, program->numPositionSets);
+
+	return program;
+}
+
+int32 FFastNoiseGraphProgram::GetNumOperands(const EOp op)
+{
+	switch (op)
+	{
+	case EOp::Add:
+	case EOp::Subtract:
+	case EOp::Multiply:
+	case EOp::Min:
+	case EOp::Max:		return 2;
+	case EOp::Remap:	return 1;
+	case EOp::Select:	return 3;
+	default:			return 0;
+	}
+}
+
+int32 FFastNoiseGraphProgram::CompileNode(FCompileContext& context, const int32 nodeIndex, const int32 positions)
+{
+	if (context.bFailed)
+	{
+		return INDEX_NONE;
+	}
+
+	if (!context.nodes.IsValidIndex(nodeIndex))
+	{
+		UE_LOG(LogFastNoiseGraph, Error, TEXT("Noise graph node %d doesn't exist"), nodeIndex);
+		context.bFailed = true;
+		return INDEX_NONE;
+	}
+
+	const TPair<int32, int32> key(nodeIndex, positions);
+
+	if (const int32* value = context.values.Find(key))
+	{
+		return *value;
+	}
+
+	if (context.visiting[nodeIndex])
+	{
+		UE_LOG(LogFastNoiseGraph, Error, TEXT("Noise graph node %d is part of a cycle"), nodeIndex);
+		context.bFailed = true;
+		return INDEX_NONE;
+	}
+
+	context.visiting[nodeIndex] = true;
+
+	const FFastNoiseGraphNode& node = context.nodes[nodeIndex];
+	FInstruction instruction;
+	int32 value = INDEX_NONE;
+
+	switch (node.type)
+	{
+	case EFastNoise_GraphNodeType::Noise:
+		if (node.noise && node.noise->IsInitialized())
+		{
+			TSharedRef<const FastNoise, ESPMode::ThreadSafe> noise = node.noise->GetSnapshot();
+
+			if (node.cellularLookup && node.cellularLookup->IsInitialized() && noise->GetNoiseType() == FastNoise::Cellular)
+			{
+				// The lookup is referenced by pointer, its snapshot lives as long as the program
+				const TSharedRef<const FastNoise, ESPMode::ThreadSafe> lookup = node.cellularLookup->GetSnapshot();
+				TSharedRef<FastNoise, ESPMode::ThreadSafe> cellular = MakeShared<FastNoise, ESPMode::ThreadSafe>(*noise);
+
+				cellular->SetCellularReturnType(FastNoise::NoiseLookup);
+				cellular->SetCellularNoiseLookup(&*lookup);
+				cellularLookups.Add(lookup);
+				noise = cellular;
+			}
+
+			instruction.op = EOp::Noise;
+			instruction.positions = positions;
+			instruction.noise = noise;
+		}
+		else
+		{
+			// Uninitialized wrappers return 0
+			instruction.op = EOp::Constant;
+		}
+		break;
+
+	case EFastNoise_GraphNodeType::Constant:
+		instruction.op = EOp::Constant;
+		instruction.param0 = node.value;
+		break;
+
+	case EFastNoise_GraphNodeType::Add:
+	case EFastNoise_GraphNodeType::Subtract:
+	case EFastNoise_GraphNodeType::Multiply:
+	case EFastNoise_GraphNodeType::Min:
+	case EFastNoise_GraphNodeType::Max:
+		instruction.op = node.type == EFastNoise_GraphNodeType::Add ? EOp::Add :
+			node.type == EFastNoise_GraphNodeType::Subtract ? EOp::Subtract :
+			node.type == EFastNoise_GraphNodeType::Multiply ? EOp::Multiply :
+			node.type == EFastNoise_GraphNodeType::Min ? EOp::Min : EOp::Max;
+		instruction.a = CompileNode(context, node.inputA, positions);
+		instruction.b = CompileNode(context, node.inputB, positions);
+		break;
+
+	case EFastNoise_GraphNodeType::Remap:
+	{
+		const float fromSize = node.fromRange.Y - node.fromRange.X;
+
+		instruction.op = EOp::Remap;
+		instruction.a = CompileNode(context, node.inputA, positions);
+		instruction.param0 = fromSize != 0.0f ? (node.toRange.Y - node.toRange.X) / fromSize : 0.0f;
+		instruction.param1 = node.toRange.X - node.fromRange.X * instruction.param0;
+		break;
+	}
+
+	case EFastNoise_GraphNodeType::Select:
+		instruction.op = EOp::Select;
+		instruction.a = CompileNode(context, node.inputA, positions);
+		instruction.b = CompileNode(context, node.inputB, positions);
+		instruction.c = CompileNode(context, node.selector, positions);
+		instruction.param0 = node.value;
+		instruction.param1 = FMath::Max(node.falloff, 0.0f);
+		break;
+
+	case EFastNoise_GraphNodeType::DomainWarp:
+	{
+		// The warp writes a new position set, the input is then compiled again for it
+		int32 warpedPositions = positions;
+
+		if (node.noise && node.noise->IsInitialized())
+		{
+			FInstruction warp;
+			warp.op = EOp::Warp;
+			warp.dest = numPositionSets++;
+			warp.a = positions;
+			warp.noise = node.noise->GetSnapshot();
+			warp.bFractalWarp = node.bFractalWarp;
+			instructions.Add(warp);
+
+			warpedPositions = warp.dest;
+		}
+
+		value = CompileNode(context, node.inputA, warpedPositions);
+		break;
+	}
+	}
+
+	if (node.type != EFastNoise_GraphNodeType::DomainWarp)
+	{
+		const int32 numOperands = GetNumOperands(instruction.op);
+		const bool bValidOperands = (numOperands < 1 || instruction.a != INDEX_NONE) && (numOperands < 2 || instruction.b != INDEX_NONE) && (numOperands < 3 || instruction.c != INDEX_NONE);
+
+		// Operands are instruction indices until the registers are allocated
+		value = bValidOperands ? instructions.Add(instruction) : INDEX_NONE;
+	}
+
+	context.visiting[nodeIndex] = false;
+
+	if (value != INDEX_NONE)
+	{
+		context.values.Add(key, value);
+	}
+
+	return value;
+}
+
+void FFastNoiseGraphProgram::AllocateRegisters(const int32 outputValue)
+{
+	// Instructions are in dependency order, a register is released after the last instruction reading it
+	TArray<int32> lastUse;
+	lastUse.Init(INDEX_NONE, instructions.Num());
+
+	for (int32 i = 0; i < instructions.Num(); i++)
+	{
+		const FInstruction& instruction = instructions[i];
+		const int32 numOperands = GetNumOperands(instruction.op);
+
+		if (numOperands > 0) lastUse[instruction.a] = i;
+		if (numOperands > 1) lastUse[instruction.b] = i;
+		if (numOperands > 2) lastUse[instruction.c] = i;
+	}
+
+	lastUse[outputValue] = instructions.Num();
+
+	TArray<int32> registers;
+	TArray<int32> freeRegisters;
+	registers.Init(INDEX_NONE, instructions.Num());
+
+	for (int32 i = 0; i < instructions.Num(); i++)
+	{
+		FInstruction& instruction = instructions[i];
+
+		if (instruction.op == EOp::Warp)
+		{
+			continue;
+		}
+
+		const int32 numOperands = GetNumOperands(instruction.op);
+		int32* operands[] = { &instruction.a, &instruction.b, &instruction.c };
+
+		// Released operands can be reused as the destination, every operation reads a sample before writing it
+		for (int32 operand = 0; operand < numOperands; operand++)
+		{
+			const int32 operandValue = *operands[operand];
+
+			if (lastUse[operandValue] == i)
+			{
+				freeRegisters.AddUnique(registers[operandValue]);
+			}
+
+			*operands[operand] = registers[operandValue];
+		}
+
+		instruction.dest = freeRegisters.Num() > 0 ? freeRegisters.Pop() : numRegisters++;
+		registers[i] = instruction.dest;
+	}
+
+	outputRegister = registers[outputValue];
+}
+
+void FFastNoiseGraphProgram::EvaluateRows(float* outNoise, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 firstRow, const int32 numRows, const bool b3D) const
+{
+	if (sizeX <= 0 || sizeY <= 0 || numRows <= 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Graph);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoiseGraph_EvaluateRows);
+
+	const int32 rowsPerBlock = FMath::Max(1, BlockSamples / sizeX);
+	TArray<float> scratch;
+	scratch.SetNumUninitialized(GetScratchSize(FMath::Min(rowsPerBlock, numRows) * sizeX));
+
+	for (int32 blockRow = 0; blockRow < numRows; blockRow += rowsPerBlock)
+	{
+		const FRows rows = { origin, step, sizeX, sizeY, firstRow + blockRow, FMath::Min(rowsPerBlock, numRows - blockRow) };
+		const int32 numSamples = rows.numRows * sizeX;
+
+		// Unwarped noise is filled row by row, the positions are only needed by the warps
+		if (numPositionSets > 1)
+		{
+			float* x = GetPositionSet(scratch.GetData(), numSamples, 0);
+			float* y = x + numSamples;
+			float* z = y + numSamples;
+
+			for (int32 row = 0; row < rows.numRows; row++)
+			{
+				const int32 j = (rows.firstRow + row) % sizeY;
+				const int32 k = (rows.firstRow + row) / sizeY;
+
+				for (int32 i = 0; i < sizeX; i++)
+				{
+					x[row * sizeX + i] = origin.X + i * step.X;
+					y[row * sizeX + i] = origin.Y + j * step.Y;
+					z[row * sizeX + i] = origin.Z + k * step.Z;
+				}
+			}
+		}
+
+		Run(outNoise + blockRow * sizeX, numSamples, &rows, b3D, scratch.GetData());
+	}
+}
+
+void FFastNoiseGraphProgram::EvaluatePositions(float* outNoise, const FVector* positions, const int32 numPositions, const bool b3D) const
+{
+	if (numPositions <= 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Graph);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoiseGraph_EvaluatePositions);
+
+	TArray<float> scratch;
+	scratch.SetNumUninitialized(GetScratchSize(FMath::Min(BlockSamples, numPositions)));
+
+	for (int32 first = 0; first < numPositions; first += BlockSamples)
+	{
+		const int32 numSamples = FMath::Min(BlockSamples, numPositions - first);
+		float* x = GetPositionSet(scratch.GetData(), numSamples, 0);
+		float* y = x + numSamples;
+		float* z = y + numSamples;
+
+		for (int32 i = 0; i < numSamples; i++)
+		{
+			x[i] = positions[first + i].X;
+			y[i] = positions[first + i].Y;
+			z[i] = positions[first + i].Z;
+		}
+
+		Run(outNoise + first, numSamples, nullptr, b3D, scratch.GetData());
+	}
+}
+
+void FFastNoiseGraphProgram::Run(float* outNoise, const int32 numSamples, const FRows* rows, const bool b3D, float* scratch) const
+{
+	// The output register is written straight into the output
+	auto getRegister = [&](const int32 index) { return index == outputRegister ? outNoise : scratch + index * numSamples; };
+
+	for (const FInstruction& instruction : instructions)
+	{
+		if (instruction.op == EOp::Warp)
+		{
+			const float* sourceX = GetPositionSet(scratch, numSamples, instruction.a);
+			const float* sourceY = sourceX + numSamples;
+			const float* sourceZ = sourceY + numSamples;
+			float* x = GetPositionSet(scratch, numSamples, instruction.dest);
+			float* y = x + numSamples;
+			float* z = y + numSamples;
+
+			for (int32 i = 0; i < numSamples; i++)
+			{
+				FN_DECIMAL warpX = sourceX[i];
+				FN_DECIMAL warpY = sourceY[i];
+
+				if (b3D)
+				{
+					FN_DECIMAL warpZ = sourceZ[i];
+
+					if (instruction.bFractalWarp) instruction.noise->GradientPerturbFractal(warpX, warpY, warpZ);
+					else instruction.noise->GradientPerturb(warpX, warpY, warpZ);
+
+					z[i] = warpZ;
+				}
+				else
+				{
+					if (instruction.bFractalWarp) instruction.noise->GradientPerturbFractal(warpX, warpY);
+					else instruction.noise->GradientPerturb(warpX, warpY);
+				}
+
+				x[i] = warpX;
+				y[i] = warpY;
+			}
+
+			continue;
+		}
+
+		float* out = getRegister(instruction.dest);
+		const float* a = getRegister(instruction.a);
+		const float* b = getRegister(instruction.b);
+		const float* c = getRegister(instruction.c);
+
+		switch (instruction.op)
+		{
+		case EOp::Noise:
+		{
+			const FastNoise& noise = *instruction.noise;
+
+			if (rows && instruction.positions == 0)
+			{
+				// Same calls as UFastNoiseWrapper::ParallelFillNoiseGrid(...), so the values match the wrapper grids
+				for (int32 row = 0; row < rows->numRows; row++)
+				{
+					const int32 j = (rows->firstRow + row) % rows->sizeY;
+					const int32 k = (rows->firstRow + row) / rows->sizeY;
+					float* rowNoise = out + row * rows->sizeX;
+
+					if (b3D)
+					{
+						noise.FillNoiseSet3D(rowNoise, rows->origin.X, rows->origin.Y + j * rows->step.Y, rows->origin.Z + k * rows->step.Z, rows->sizeX, 1, 1, rows->step.X, rows->step.Y, rows->step.Z);
+					}
+					else
+					{
+						noise.FillNoiseSet2D(rowNoise, rows->origin.X, rows->origin.Y + j * rows->step.Y, rows->sizeX, 1, rows->step.X, rows->step.Y);
+					}
+				}
+			}
+			else
+			{
+				const float* x = GetPositionSet(scratch, numSamples, instruction.positions);
+				const float* y = x + numSamples;
+				const float* z = y + numSamples;
+
+				if (b3D)
+				{
+					noise.FillNoiseSetPoints3D(out, x, y, z, numSamples);
+				}
+				else
+				{
+					noise.FillNoiseSetPoints2D(out, x, y, numSamples);
+				}
+			}
+			break;
+		}
+
+		case EOp::Constant:
+			for (int32 i = 0; i < numSamples; i++)
+				out[i] = instruction.param0;
+			break;
+
+		case EOp::Add:
+			for (int32 i = 0; i < numSamples; i++)
+				out[i] = a[i] + b[i];
+			break;
+
+		case EOp::Subtract:
+			for (int32 i = 0; i < numSamples; i++)
+				out[i] = a[i] - b[i];
+			break;
+
+		case EOp::Multiply:
+			for (int32 i = 0; i < numSamples; i++)
+				out[i] = a[i] * b[i];
+			break;
+
+		case EOp::Min:
+			for (int32 i = 0; i < numSamples; i++)
+				out[i] = FMath::Min(a[i], b[i]);
+			break;
+
+		case EOp::Max:
+			for (int32 i = 0; i < numSamples; i++)
+				out[i] = FMath::Max(a[i], b[i]);
+			break;
+
+		case EOp::Remap:
+			for (int32 i = 0; i < numSamples; i++)
+				out[i] = a[i] * instruction.param0 + instruction.param1;
+			break;
+
+		case EOp::Select:
+			if (instruction.param1 > 0.0f)
+			{
+				const float blendStart = instruction.param0 - instruction.param1;
+				const float invBlendSize = 0.5f / instruction.param1;
+
+				for (int32 i = 0; i < numSamples; i++)
+				{
+					const float t = FMath::Clamp((c[i] - blendStart) * invBlendSize, 0.0f, 1.0f);
+					out[i] = a[i] + (b[i] - a[i]) * t;
+				}
+			}
+			else
+			{
+				for (int32 i = 0; i < numSamples; i++)
+					out[i] = c[i] >= instruction.param0 ? b[i] : a[i];
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+}
@@ -0,0 +1,492 @@
+// FastNoiseGraph.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "FastNoiseWrapper.h"
+#include "FastNoiseGraph.generated.h"
+
+// Operations of the noise graph nodes
+UENUM(BlueprintType) enum class EFastNoise_GraphNodeType			: uint8 { Noise, Constant, Add, Subtract, Multiply, Min, Max, Remap, Select, DomainWarp };
+
+/**
+ * Node of a UFastNoiseGraph, inputs are indices of other nodes of the same graph
+ */
+USTRUCT(BlueprintType)
+struct PROJECT_API FFastNoiseGraphNode
+{
+	GENERATED_BODY()
+
+	/** Operation of the node */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	EFastNoise_GraphNodeType type = EFastNoise_GraphNodeType::Noise;
+
+	/** Noise sampled by Noise nodes, warp settings of DomainWarp nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	UFastNoiseWrapper* noise = nullptr;
+
+	/** Noise returned at the cell of each sample by Noise nodes whose noise is Cellular, replacing its cellular return type */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	UFastNoiseWrapper* cellularLookup = nullptr;
+
+	/** First input of the math, Remap, Select and DomainWarp nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	int32 inputA = INDEX_NONE;
+
+	/** Second input of the math and Select nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	int32 inputB = INDEX_NONE;
+
+	/** Input compared with the threshold by Select nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	int32 selector = INDEX_NONE;
+
+	/** Value of Constant nodes, threshold of Select nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	float value = 0.0f;
+
+	/** Half width of the blend between the inputs of Select nodes around the threshold, 0 for a hard switch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	float falloff = 0.0f;
+
+	/** Range mapped to toRange by Remap nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	FVector2D fromRange = FVector2D(-1.0f, 1.0f);
+
+	/** Range fromRange is mapped to by Remap nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	FVector2D toRange = FVector2D(0.0f, 1.0f);
+
+	/** Whether DomainWarp nodes use the fractal warp */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Graph")
+	bool bFractalWarp = false;
+};
+
+/**
+ * Flat evaluation program compiled from a UFastNoiseGraph.
+ * It holds snapshots of the noise settings of the graph, so it can be shared and run on any thread.
+ * Samples go through the instructions in blocks of up to BlockSamples, each instruction running over the whole block
+ */
+class PROJECT_API FFastNoiseGraphProgram
+{
+public:
+
+	/** Number of samples going through the instructions at once, sized so the scratch registers of a block stay in cache */
+	static constexpr int32 BlockSamples = 4096;
+
+	/**
+	* Compiles the nodes into a program, nodes reached from different DomainWarp nodes are evaluated once per warp.
+	* Must be called on the game thread, it reads the settings of the wrappers
+	*
+	* @param nodes		- the nodes of the graph
+	* @param outputNode	- the node whose value is returned
+	* @return the program, invalid if a node has a missing input or the nodes form a cycle
+	*/
+	static TSharedPtr<const FFastNoiseGraphProgram, ESPMode::ThreadSafe> Compile(const TArray<FFastNoiseGraphNode>& nodes, const int32 outputNode);
+
+	/**
+	* Evaluates numRows rows of a grid starting at firstRow, row j + k * sizeY holding the samples (0..sizeX - 1, j, k).
+	* Noise nodes sampling unwarped positions match GetNoise2DGridAsync/GetNoise3DGridAsync(...) of their wrapper
+	*
+	* @param outNoise	- the numRows * sizeX output values
+	*/
+	void EvaluateRows(float* outNoise, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 firstRow, const int32 numRows, const bool b3D) const;
+
+	/** Evaluates scattered positions, the z of the positions is ignored in 2D */
+	void EvaluatePositions(float* outNoise, const FVector* positions, const int32 numPositions, const bool b3D) const;
+
+	/** Returns the number of instructions, one per node and position set it is evaluated with */
+	int32 Num() const { return instructions.Num(); }
+
+private:
+
+	enum class EOp : uint8 { Noise, Constant, Add, Subtract, Multiply, Min, Max, Remap, Select, Warp };
+
+	struct FInstruction
+	{
+		EOp op = EOp::Constant;
+		/** Register written, or position set for Warp */
+		int32 dest = 0;
+		/** Registers read, a being the position set read for Warp */
+		int32 a = 0;
+		int32 b = 0;
+		int32 c = 0;
+		/** Position set sampled by Noise */
+		int32 positions = 0;
+		TSharedPtr<const FastNoise, ESPMode::ThreadSafe> noise;
+		/** Constant value, Select threshold and falloff, or Remap scale and offset */
+		float param0 = 0.0f;
+		float param1 = 0.0f;
+		bool bFractalWarp = false;
+	};
+
+	/** Rows of a grid being evaluated, so unwarped Noise instructions can use FillNoiseSet */
+	struct FRows
+	{
+		FVector origin;
+		FVector step;
+		int32 sizeX;
+		int32 sizeY;
+		int32 firstRow;
+		int32 numRows;
+	};
+
+	struct FCompileContext;
+
+	static int32 GetNumOperands(const EOp op);
+
+	int32 CompileNode(FCompileContext& context, const int32 nodeIndex, const int32 positions);
+	void AllocateRegisters(const int32 outputValue);
+	void Run(float* outNoise, const int32 numSamples, const FRows* rows, const bool b3D, float* scratch) const;
+
+	/** Registers first, then the x, y and z arrays of each position set */
+	int32 GetScratchSize(const int32 numSamples) const { return (numRegisters + numPositionSets * 3) * numSamples; }
+	float* GetPositionSet(float* scratch, const int32 numSamples, const int32 set) const { return scratch + (numRegisters + set * 3) * numSamples; }
+
+	TArray<FInstruction> instructions;
+	/** Lookups of the cellular Noise instructions, referenced by their noise */
+	TArray<TSharedRef<const FastNoise, ESPMode::ThreadSafe>> cellularLookups;
+	int32 numRegisters = 0;
+	int32 numPositionSets = 1;
+	int32 outputRegister = 0;
+};
+
+/**
+ * Composition of several noises and math operations, compiled into a flat program evaluated over blocks of samples.
+ * Build it with the Add*Node functions, each one returning the index of the new node, the last node added being the output
+ * unless SetOutputNode(...) is called. Call Compile() after changing the nodes or the settings of their wrappers,
+ * the Get* functions compile the graph the first time they are called
+ */
+UCLASS(BlueprintType)
+class PROJECT_API UFastNoiseGraph : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	* Adds a node sampling a noise
+	*
+	* @param noise			- the noise settings
+	* @param cellularLookup	- for Cellular noise, the noise returned at the cell of each sample instead of the cellular return type
+	* @return the index of the node
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	int32 AddNoiseNode(UFastNoiseWrapper* noise, UFastNoiseWrapper* cellularLookup = nullptr)
+	{
+		FFastNoiseGraphNode node;
+		node.type = EFastNoise_GraphNodeType::Noise;
+		node.noise = noise;
+		node.cellularLookup = cellularLookup;
+		return AddNode(node);
+	}
+
+	/** Adds a node returning a constant value, returns the index of the node */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	int32 AddConstantNode(const float value)
+	{
+		FFastNoiseGraphNode node;
+		node.type = EFastNoise_GraphNodeType::Constant;
+		node.value = value;
+		return AddNode(node);
+	}
+
+	/**
+	* Adds a node combining two nodes
+	*
+	* @param type	- Add, Subtract, Multiply, Min or Max
+	* @param inputA	- the first operand
+	* @param inputB	- the second operand
+	* @return the index of the node
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	int32 AddMathNode(const EFastNoise_GraphNodeType type, const int32 inputA, const int32 inputB)
+	{
+		FFastNoiseGraphNode node;
+		node.type = type;
+		node.inputA = inputA;
+		node.inputB = inputB;
+		return AddNode(node);
+	}
+
+	/**
+	* Adds a node linearly mapping the value of a node from a range to another one, without clamping
+	*
+	* @param input		- the node remapped
+	* @param fromRange	- the range of the input. Default value: (-1, 1)
+	* @param toRange	- the range of the output. Default value: (0, 1)
+	* @return the index of the node
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	int32 AddRemapNode(const int32 input, const FVector2D fromRange = FVector2D(-1.0f, 1.0f), const FVector2D toRange = FVector2D(0.0f, 1.0f))
+	{
+		FFastNoiseGraphNode node;
+		node.type = EFastNoise_GraphNodeType::Remap;
+		node.inputA = input;
+		node.fromRange = fromRange;
+		node.toRange = toRange;
+		return AddNode(node);
+	}
+
+	/**
+	* Adds a node returning inputA where the selector is below the threshold and inputB above it
+	*
+	* @param inputA		- the value below the threshold
+	* @param inputB		- the value above the threshold
+	* @param selector	- the node compared with the threshold
+	* @param threshold	- the selector value switching between the inputs
+	* @param falloff	- half width of the linear blend between the inputs around the threshold, 0 for a hard switch
+	* @return the index of the node
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	int32 AddSelectNode(const int32 inputA, const int32 inputB, const int32 selector, const float threshold = 0.0f, const float falloff = 0.0f)
+	{
+		FFastNoiseGraphNode node;
+		node.type = EFastNoise_GraphNodeType::Select;
+		node.inputA = inputA;
+		node.inputB = inputB;
+		node.selector = selector;
+		node.value = threshold;
+		node.falloff = falloff;
+		return AddNode(node);
+	}
+
+	/**
+	* Adds a node sampling another node at positions warped by gradient perturbation, like GradientPerturb2D/3D(...)
+	*
+	* @param input			- the node sampled at the warped positions
+	* @param warpNoise		- the warp settings
+	* @param bFractalWarp	- whether to use the fractal version of the warp
+	* @return the index of the node
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	int32 AddDomainWarpNode(const int32 input, UFastNoiseWrapper* warpNoise, const bool bFractalWarp = false)
+	{
+		FFastNoiseGraphNode node;
+		node.type = EFastNoise_GraphNodeType::DomainWarp;
+		node.inputA = input;
+		node.noise = warpNoise;
+		node.bFractalWarp = bFractalWarp;
+		return AddNode(node);
+	}
+
+	/** Adds a node, returns its index */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	int32 AddNode(const FFastNoiseGraphNode& node)
+	{
+		ResetProgram();
+		return nodes.Add(node);
+	}
+
+	/** Sets the node whose value the graph returns, INDEX_NONE for the last node */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	void SetOutputNode(const int32 node) { outputNode = node; ResetProgram(); }
+
+	/** Removes every node */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	void Empty() { nodes.Empty(); outputNode = INDEX_NONE; ResetProgram(); }
+
+	/** Returns the nodes of the graph */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Graph")
+	const TArray<FFastNoiseGraphNode>& GetNodes() const { return nodes; }
+
+	/** Compiles the nodes with the current settings of their wrappers, returns false and logs the error if the graph is invalid */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	bool Compile()
+	{
+		program = FFastNoiseGraphProgram::Compile(nodes, outputNode == INDEX_NONE ? nodes.Num() - 1 : outputNode);
+		bCompiled = true;
+		return program.IsValid();
+	}
+
+	/** Returns the compiled program, compiling the graph the first time it is called. Invalid if the graph is */
+	TSharedPtr<const FFastNoiseGraphProgram, ESPMode::ThreadSafe> GetProgram()
+	{
+		if (!bCompiled)
+		{
+			Compile();
+		}
+
+		return program;
+	}
+
+	/**
+	* Returns the graph value given x and y values
+	*
+	* @param x	- the x value
+	* @param y	- the y value
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	float GetNoise2D(const float x, const float y) { return GetNoise(FVector(x, y, 0.0f), false); }
+
+	/**
+	* Returns the graph value given x, y and z values
+	*
+	* @param x	- the x value
+	* @param y	- the y value
+	* @param z	- the z value
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	float GetNoise3D(const float x, const float y, const float z = 0.0f) { return GetNoise(FVector(x, y, z), true); }
+
+	/**
+	* Fills a grid of graph values, laid out like UFastNoiseWrapper::GetNoise2DGrid(...)
+	*
+	* @param origin		- the x and y values of the first sample
+	* @param step		- the distance between two consecutive samples on each axis
+	* @param sizeX		- the number of samples along x
+	* @param sizeY		- the number of samples along y
+	* @param outNoise	- the sizeX * sizeY values, sample (i, j) being at index i + j * sizeX
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	void GetNoise2DGrid(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, TArray<float>& outNoise)
+	{
+		FillGrid(GetProgram(), FVector(origin, 0.0f), FVector(step, 0.0f), sizeX, sizeY, 1, false, outNoise);
+	}
+
+	/**
+	* Fills a volume of graph values, laid out like UFastNoiseWrapper::GetNoise3DGrid(...)
+	*
+	* @param origin		- the x, y and z values of the first sample
+	* @param step		- the distance between two consecutive samples on each axis
+	* @param sizeX		- the number of samples along x
+	* @param sizeY		- the number of samples along y
+	* @param sizeZ		- the number of samples along z
+	* @param outNoise	- the sizeX * sizeY * sizeZ values, sample (i, j, k) being at index i + (j + k * sizeY) * sizeX
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Graph")
+	void GetNoise3DGrid(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArray<float>& outNoise)
+	{
+		FillGrid(GetProgram(), origin, step, sizeX, sizeY, sizeZ, true, outNoise);
+	}
+
+	/**
+	* Generates the same grid as GetNoise2DGrid(...) on the task graph, in tiles of UFastNoiseWrapper::AsyncTileSamples samples.
+	* The program compiled when the function is called is used, changing the graph afterwards doesn't affect the generation
+	*
+	* @return a future holding the sizeX * sizeY values, sample (i, j) being at index i + j * sizeX
+	*/
+	TFuture<TArray<float>> GetNoise2DGridAsync(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY)
+	{
+		return GetNoiseGridAsync(FVector(origin, 0.0f), FVector(step, 0.0f), sizeX, sizeY, 1, false);
+	}
+
+	/**
+	* Generates the same volume as GetNoise3DGrid(...) on the task graph, in tiles of UFastNoiseWrapper::AsyncTileSamples samples.
+	* The program compiled when the function is called is used, changing the graph afterwards doesn't affect the generation
+	*
+	* @return a future holding the sizeX * sizeY * sizeZ values, sample (i, j, k) being at index i + (j + k * sizeY) * sizeX
+	*/
+	TFuture<TArray<float>> GetNoise3DGridAsync(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ)
+	{
+		return GetNoiseGridAsync(origin, step, sizeX, sizeY, sizeZ, true);
+	}
+
+private:
+
+	/** Drops the compiled program, the next evaluation compiles the graph again */
+	void ResetProgram()
+	{
+		program.Reset();
+		bCompiled = false;
+	}
+
+	float GetNoise(const FVector& position, const bool b3D)
+	{
+		const TSharedPtr<const FFastNoiseGraphProgram, ESPMode::ThreadSafe> compiled = GetProgram();
+		float noise = 0.0f;
+
+		if (compiled.IsValid())
+		{
+			compiled->EvaluatePositions(&noise, &position, 1, b3D);
+		}
+
+		return noise;
+	}
+
+	static void FillGrid(const TSharedPtr<const FFastNoiseGraphProgram, ESPMode::ThreadSafe>& compiled, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D, TArray<float>& outNoise)
+	{
+		outNoise.SetNumUninitialized(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0));
+
+		if (compiled.IsValid() && outNoise.Num() > 0)
+		{
+			compiled->EvaluateRows(outNoise.GetData(), origin, step, sizeX, sizeY, 0, sizeY * sizeZ, b3D);
+		}
+		else
+		{
+			FMemory::Memzero(outNoise.GetData(), outNoise.Num() * sizeof(float));
+		}
+	}
+
+	TFuture<TArray<float>> GetNoiseGridAsync(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D)
+	{
+		const TSharedPtr<const FFastNoiseGraphProgram, ESPMode::ThreadSafe> compiled = GetProgram();
+
+		return Async(EAsyncExecution::TaskGraph, [compiled, origin, step, sizeX, sizeY, sizeZ, b3D]()
+		{
+			TArray<float> outNoise;
+			outNoise.SetNumUninitialized(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0));
+
+			if (!compiled.IsValid() || outNoise.Num() == 0)
+			{
+				FMemory::Memzero(outNoise.GetData(), outNoise.Num() * sizeof(float));
+				return outNoise;
+			}
+
+			// Each tile covers whole rows, so the values match the single threaded grid functions
+			const int32 numRows = sizeY * sizeZ;
+			const int32 rowsPerTile = FMath::Max(1, UFastNoiseWrapper::AsyncTileSamples / sizeX);
+			const int32 numTiles = FMath::DivideAndRoundUp(numRows, rowsPerTile);
+
+			ParallelFor(numTiles, [&](const int32 tile)
+			{
+				const int32 firstRow = tile * rowsPerTile;
+				const int32 lastRow = FMath::Min(numRows, firstRow + rowsPerTile);
+
+				compiled->EvaluateRows(outNoise.GetData() + firstRow * sizeX, origin, step, sizeX, sizeY, firstRow, lastRow - firstRow, b3D);
+			});
+
+			return outNoise;
+		});
+	}
+
+	UPROPERTY()
+	TArray<FFastNoiseGraphNode> nodes;
+
+	/** Saved with the nodes, INDEX_NONE returning the last node */
+	UPROPERTY()
+	int32 outputNode = INDEX_NONE;
+
+	TSharedPtr<const FFastNoiseGraphProgram, ESPMode::ThreadSafe> program;
+	bool bCompiled = false;
+};
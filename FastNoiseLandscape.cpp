@@ -0,0 +1,289 @@
+// FastNoiseLandscape.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseLandscape.h"
+
+#if WITH_EDITOR
+
+#include "FastNoiseWrapper.h"
+#include "FastNoiseGraph.h"
+#include "FastNoiseStats.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Landscape.h"
+#include "LandscapeComponent.h"
+#include "LandscapeDataAccess.h"
+#include "LandscapeEdit.h"
+#include "LandscapeInfo.h"
+#include "LandscapeLayerInfoObject.h"
+#include "Misc/ScopedSlowTask.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFastNoiseLandscape, Log, All);
+
+#define LOCTEXT_NAMESPACE "FastNoiseLandscape"
+
+int32 FFastNoiseLandscape::Generate(ALandscapeProxy* landscape, const FFastNoiseLandscapeSettings& settings)
+{
+	ULandscapeInfo* info = landscape ? landscape->GetLandscapeInfo() : nullptr;
+
+	if (!info)
+	{
+		UE_LOG(LogFastNoiseLandscape, Warning, TEXT("Couldn't generate the noise, the landscape isn't registered"));
+		return 0;
+	}
+
+	const TSharedRef<FContext, ESPMode::ThreadSafe> context = MakeShared<FContext, ESPMode::ThreadSafe>();
+	context->landscapeToWorld = landscape->LandscapeActorToWorld();
+	context->heights = MakeSource(settings.heightNoise, settings.heightGraph);
+	context->heightOffset = settings.heightOffset;
+	context->heightScale = settings.heightScale;
+
+	TArray<ULandscapeLayerInfoObject*> layerInfos;
+
+	for (const FFastNoiseLandscapeLayer& layer : settings.layers)
+	{
+		FSource source = MakeSource(layer.noise, layer.graph);
+
+		if (!layer.layerInfo || !source.IsValid() || layer.noiseRange.X == layer.noiseRange.Y)
+		{
+			UE_LOG(LogFastNoiseLandscape, Warning, TEXT("Skipping layer %s, it needs a layer info, an initialized noise or a valid graph, and a noise range"), layer.layerInfo ? *layer.layerInfo->LayerName.ToString() : TEXT("None"));
+			continue;
+		}
+
+		layerInfos.Add(layer.layerInfo);
+		context->layers.Add(MoveTemp(source));
+		context->layerRanges.Add(layer.noiseRange);
+	}
+
+	const bool bHeights = context->heights.IsValid();
+
+	TArray<FIntRect> extents;
+
+	for (const TPair<FIntPoint, ULandscapeComponent*>& pair : info->XYtoComponentMap)
+	{
+		if (pair.Value)
+		{
+			FIntRect extent;
+			pair.Value->GetComponentExtent(extent.Min.X, extent.Min.Y, extent.Max.X, extent.Max.Y);
+			extents.Add(extent);
+		}
+	}
+
+	if (extents.Num() == 0 || (!bHeights && layerInfos.Num() == 0))
+	{
+		return 0;
+	}
+
+	// Row by row, so the components of a batch are neighbours and share the textures the edit interface loads
+	extents.Sort([](const FIntRect& a, const FIntRect& b) { return a.Min.Y != b.Min.Y ? a.Min.Y < b.Min.Y : a.Min.X < b.Min.X; });
+
+	const int32 batchSize = settings.componentsPerBatch > 0 ? settings.componentsPerBatch : FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	const int32 numBatches = FMath::DivideAndRoundUp(extents.Num(), batchSize);
+
+	const auto getBatch = [&extents, batchSize](const int32 batch)
+	{
+		return TArray<FIntRect>(extents.GetData() + batch * batchSize, FMath::Min(batchSize, extents.Num() - batch * batchSize));
+	};
+
+	FScopedSlowTask slowTask(float(extents.Num()), LOCTEXT("Generating", "Generating the landscape noise"));
+	slowTask.MakeDialog(true);
+
+	// Landscapes with edit layers are written to their first layer, the final heights are resolved once the generation is done
+	ALandscape* landscapeActor = info->LandscapeActor.Get();
+	TOptional<FScopedSetLandscapeEditingLayer> editingLayer;
+
+	if (landscapeActor && landscapeActor->HasLayersContent() && landscapeActor->GetLayerCount() > 0)
+	{
+		editingLayer.Emplace(landscapeActor, landscapeActor->GetLayer(0)->Guid, [landscapeActor]() { landscapeActor->RequestLayersContentUpdateForceAll(); });
+	}
+
+	// The next batch is generated on the task graph while the game thread commits the current one
+	TFuture<TArray<FComponentData>> pending = GenerateBatchAsync(context, getBatch(0));
+	int32 numGenerated = 0;
+
+	for (int32 batch = 0; batch < numBatches; batch++)
+	{
+		TFuture<TArray<FComponentData>> current = MoveTemp(pending);
+
+		if (batch + 1 < numBatches)
+		{
+			pending = GenerateBatchAsync(context, getBatch(batch + 1));
+		}
+
+		const TArray<FComponentData>& components = current.Get();
+		Commit(info, components, layerInfos, bHeights);
+
+		numGenerated += components.Num();
+		slowTask.EnterProgressFrame(float(components.Num()));
+
+		// A batch still generating finishes on its own, its values are dropped
+		if (slowTask.ShouldCancel())
+		{
+			break;
+		}
+	}
+
+	return numGenerated;
+}
+
+void FFastNoiseLandscape::FSource::Fill(float* outNoise, const FVector2D& origin, const FVector2D& step, const int32 sizeX, const int32 sizeY) const
+{
+	if (evaluator.IsSet())
+	{
+		evaluator->FillNoise2DGrid(origin, step, sizeX, sizeY, TArrayView<float>(outNoise, sizeX * sizeY));
+	}
+	else if (program.IsValid())
+	{
+		program->EvaluateRows(outNoise, FVector(origin, 0.0f), FVector(step, 0.0f), sizeX, sizeY, 0, sizeY, false);
+	}
+	else
+	{
+		FMemory::Memzero(outNoise, sizeX * sizeY * sizeof(float));
+	}
+}
+
+FFastNoiseLandscape::FSource FFastNoiseLandscape::MakeSource(UFastNoiseWrapper* noise, UFastNoiseGraph* graph)
+{
+	FSource source;
+
+	if (graph)
+	{
+		source.program = graph->GetProgram();
+	}
+	else if (noise && noise->IsInitialized())
+	{
+		source.evaluator.Emplace(noise->GetEvaluator());
+	}
+
+	return source;
+}
+
+TFuture<TArray<FFastNoiseLandscape::FComponentData>> FFastNoiseLandscape::GenerateBatchAsync(const TSharedRef<const FContext, ESPMode::ThreadSafe>& context, TArray<FIntRect> extents)
+{
+	INC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+
+	return Async(EAsyncExecution::TaskGraph, [context, extents = MoveTemp(extents)]()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FastNoise_AsyncJob);
+		TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_LandscapeBatch);
+
+		TArray<FComponentData> batch;
+		batch.SetNum(extents.Num());
+
+		ParallelFor(extents.Num(), [&](const int32 index)
+		{
+			batch[index] = GenerateComponent(*context, extents[index]);
+		});
+
+		DEC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+		return batch;
+	});
+}
+
+FFastNoiseLandscape::FComponentData FFastNoiseLandscape::GenerateComponent(const FContext& context, const FIntRect& extent)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_LandscapeComponent);
+
+	const int32 sizeX = extent.Width() + 1;
+	const int32 sizeY = extent.Height() + 1;
+	const int32 numSamples = sizeX * sizeY;
+
+	const FVector origin = context.landscapeToWorld.TransformPosition(FVector(extent.Min.X, extent.Min.Y, 0.0f));
+	const FVector scale = context.landscapeToWorld.GetScale3D();
+	const FVector2D step(scale.X, scale.Y);
+
+	FComponentData data;
+	data.extent = extent;
+
+	TArray<float> noise;
+	noise.SetNumUninitialized(numSamples);
+
+	if (context.heights.IsValid())
+	{
+		context.heights.Fill(noise.GetData(), FVector2D(origin), step, sizeX, sizeY);
+
+		// Heights are stored as the height over the landscape in local units divided by LANDSCAPE_ZSCALE, 0 being at MidValue
+		const float worldToTexHeight = LANDSCAPE_INV_ZSCALE / scale.Z;
+		const float heightScale = context.heightScale * worldToTexHeight;
+		const float heightBias = (context.heightOffset - origin.Z) * worldToTexHeight + LandscapeDataAccess::MidValue;
+
+		data.heights.SetNumUninitialized(numSamples);
+
+		for (int32 i = 0; i < numSamples; i++)
+			data.heights[i] = uint16(FMath::Clamp(noise[i] * heightScale + heightBias, 0.0f, float(LandscapeDataAccess::MaxValue)) + 0.5f);
+	}
+
+	data.weights.SetNum(context.layers.Num());
+
+	for (int32 layer = 0; layer < context.layers.Num(); layer++)
+	{
+		context.layers[layer].Fill(noise.GetData(), FVector2D(origin), step, sizeX, sizeY);
+
+		const FVector2D& range = context.layerRanges[layer];
+		const float weightScale = 1.0f / (range.Y - range.X);
+		const float weightBias = -range.X * weightScale;
+		TArray<uint8>& weights = data.weights[layer];
+
+		weights.SetNumUninitialized(numSamples);
+
+		for (int32 i = 0; i < numSamples; i++)
+			weights[i] = uint8(FMath::Clamp(noise[i] * weightScale + weightBias, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	return data;
+}
+
+void FFastNoiseLandscape::Commit(ULandscapeInfo* info, const TArray<FComponentData>& batch, const TArray<ULandscapeLayerInfoObject*>& layerInfos, const bool bHeights)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_LandscapeCommit);
+
+	// One interface per batch, so the textures it loads are released as the generation goes
+	FLandscapeEditDataInterface landscapeEdit(info);
+
+	for (const FComponentData& component : batch)
+	{
+		const FIntRect& extent = component.extent;
+
+		if (bHeights)
+		{
+			landscapeEdit.SetHeightData(extent.Min.X, extent.Min.Y, extent.Max.X, extent.Max.Y, component.heights.GetData(), 0, true);
+		}
+
+		for (int32 layer = 0; layer < layerInfos.Num(); layer++)
+		{
+			landscapeEdit.SetAlphaData(layerInfos[layer], extent.Min.X, extent.Min.Y, extent.Max.X, extent.Max.Y, component.weights[layer].GetData(), 0, ELandscapeLayerPaintingRestriction::None, !layerInfos[layer]->bNoWeightBlend, false);
+		}
+	}
+
+	landscapeEdit.Flush();
+}
+
+#undef LOCTEXT_NAMESPACE
+
+#endif
@@ -0,0 +1,136 @@
+// FastNoiseLandscape.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+#include "Async/Future.h"
+#include "Misc/Optional.h"
+#include "FastNoiseSettings.h"
+
+class ALandscapeProxy;
+class ULandscapeInfo;
+class ULandscapeLayerInfoObject;
+class UFastNoiseWrapper;
+class UFastNoiseGraph;
+class FFastNoiseGraphProgram;
+
+/** Weight layer painted by FFastNoiseLandscape::Generate(...) */
+struct PROJECT_API FFastNoiseLandscapeLayer
+{
+	/** Layer painted, it must already be added to the landscape */
+	ULandscapeLayerInfoObject* layerInfo = nullptr;
+
+	/** Noise giving the weights, the graph being used instead when set */
+	UFastNoiseWrapper* noise = nullptr;
+	UFastNoiseGraph* graph = nullptr;
+
+	/** Noise values mapped to the weights 0 and 1, the weights being clamped outside */
+	FVector2D noiseRange = FVector2D(-1.0f, 1.0f);
+};
+
+/** What FFastNoiseLandscape::Generate(...) writes to the landscape */
+struct PROJECT_API FFastNoiseLandscapeSettings
+{
+	/** Noise giving the heights, the graph being used instead when set. Without either, only the weight layers are painted */
+	UFastNoiseWrapper* heightNoise = nullptr;
+	UFastNoiseGraph* heightGraph = nullptr;
+
+	/** World height of the noise value 0, and world height added per noise unit */
+	float heightOffset = 0.0f;
+	float heightScale = 25600.0f;
+
+	TArray<FFastNoiseLandscapeLayer> layers;
+
+	/** Number of components generated at once, 0 for one per worker thread. Two batches are in memory at a time */
+	int32 componentsPerBatch = 0;
+};
+
+/**
+ * Editor generation of landscape heightmaps and weightmaps from wrapper or graph noise, replacing per sample calls and full resolution
+ * intermediates for large landscapes. Components are generated in batches on the task graph, each component quantizing its noise
+ * straight into the uint16 heights and uint8 weights of the landscape, and every batch is committed to the landscape while the next one
+ * is generated, so the memory used is bounded by two batches whatever the landscape size. The noise is sampled at the world X and Y of
+ * the landscape vertices, shared edges getting the same values from both components, for landscapes that aren't rotated.
+ * Needs the Landscape module. The generation isn't recorded for undo
+ */
+class PROJECT_API FFastNoiseLandscape
+{
+public:
+
+	/**
+	* Writes the heights and the weight layers of every component of a landscape, showing a cancelable progress dialog
+	*
+	* @param landscape	- any proxy of the landscape, the components of all its proxies are generated
+	* @param settings	- the noises and how they are mapped to heights and weights
+	* @return the number of components generated, less than all of them if the generation is cancelled
+	*/
+	static int32 Generate(ALandscapeProxy* landscape, const FFastNoiseLandscapeSettings& settings);
+
+private:
+
+	/** Noise of a wrapper or a graph, read on the task graph */
+	struct FSource
+	{
+		TOptional<FFastNoiseEvaluator> evaluator;
+		TSharedPtr<const FFastNoiseGraphProgram, ESPMode::ThreadSafe> program;
+
+		bool IsValid() const { return evaluator.IsSet() || program.IsValid(); }
+		void Fill(float* outNoise, const FVector2D& origin, const FVector2D& step, const int32 sizeX, const int32 sizeY) const;
+	};
+
+	/** What the tasks read, shared by all the batches */
+	struct FContext
+	{
+		FTransform landscapeToWorld;
+		FSource heights;
+		TArray<FSource> layers;
+		TArray<FVector2D> layerRanges;
+		float heightOffset = 0.0f;
+		float heightScale = 0.0f;
+	};
+
+	/** Quantized values of one component over its inclusive vertex extent, vertex (x, y) being at index (x - minX) + (y - minY) * (maxX - minX + 1) */
+	struct FComponentData
+	{
+		FIntRect extent;
+		TArray<uint16> heights;
+		TArray<TArray<uint8>> weights;
+	};
+
+	static FSource MakeSource(UFastNoiseWrapper* noise, UFastNoiseGraph* graph);
+	static TFuture<TArray<FComponentData>> GenerateBatchAsync(const TSharedRef<const FContext, ESPMode::ThreadSafe>& context, TArray<FIntRect> extents);
+	static FComponentData GenerateComponent(const FContext& context, const FIntRect& extent);
+	static void Commit(ULandscapeInfo* info, const TArray<FComponentData>& batch, const TArray<ULandscapeLayerInfoObject*>& layerInfos, const bool bHeights);
+};
+
+#endif
@@ -0,0 +1,518 @@
+// FastNoiseNiagara.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseNiagara.h"
+#include "FastNoiseCompute.h"
+#include "FastNoiseStats.h"
+#include "NiagaraShader.h"
+#include "NiagaraTypes.h"
+#include "RenderingThread.h"
+#include "ShaderCore.h"
+#include "ShaderParameterUtils.h"
+#include "VectorVM.h"
+
+#define LOCTEXT_NAMESPACE "FastNoiseNiagara"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFastNoiseNiagara, Log, All);
+
+const FName UNiagaraDataInterfaceFastNoise::SampleNoise2DName(TEXT("SampleNoise2D"));
+const FName UNiagaraDataInterfaceFastNoise::SampleNoise3DName(TEXT("SampleNoise3D"));
+
+namespace FastNoiseNiagara
+{
+	/** Names of the shader parameters in Shaders/FastNoiseCommon.ush, suffixed by the HLSL symbol of each data interface */
+	static const TCHAR* const TableNames[] = { TEXT("Perm"), TEXT("Perm12"), TEXT("GradX"), TEXT("GradY"), TEXT("GradZ"), TEXT("ValLut"), TEXT("Cell2DX"), TEXT("Cell2DY"), TEXT("Cell3DX"), TEXT("Cell3DY"), TEXT("Cell3DZ") };
+	static const TCHAR* const IntSettingNames[] = { TEXT("Seed"), TEXT("IndexMode"), TEXT("NoiseType"), TEXT("Interp"), TEXT("FractalType"), TEXT("Octaves"), TEXT("CellularDistanceFunction"), TEXT("CellularReturnType"), TEXT("CellularDistanceIndex0"), TEXT("CellularDistanceIndex1") };
+	static const TCHAR* const FloatSettingNames[] = { TEXT("Frequency"), TEXT("Lacunarity"), TEXT("Gain"), TEXT("FractalBounding"), TEXT("CellularJitter") };
+
+	static constexpr int32 NumTables = UE_ARRAY_COUNT(TableNames);
+	static constexpr int32 NumIntSettings = UE_ARRAY_COUNT(IntSettingNames);
+	static constexpr int32 NumFloatSettings = UE_ARRAY_COUNT(FloatSettingNames);
+
+	/** The permutation tables depend on the seed, the other tables are the same for every data interface */
+	static constexpr int32 NumPermutationTables = 2;
+
+	/** Everything the shader reads from FastNoise, in the order of the names above */
+	struct FGPUSettings
+	{
+		TArray<uint32> perm;
+		TArray<uint32> perm12;
+		int32 ints[NumIntSettings];
+		float floats[NumFloatSettings];
+	};
+
+	static FGPUSettings GetGPUSettings(const FastNoise& noise)
+	{
+		FGPUSettings settings;
+		FFastNoiseCompute::GetPermutationTables(noise, settings.perm, settings.perm12);
+
+		settings.ints[0] = noise.GetSeed();
+		settings.ints[1] = noise.GetIndexMode();
+		settings.ints[2] = noise.GetNoiseType();
+		settings.ints[3] = noise.GetInterp();
+		settings.ints[4] = noise.GetFractalType();
+		// Same as FFastNoiseCompute, the octaves left by the amplitude threshold with the fractal bounding of all of them
+		settings.ints[5] = noise.GetFractalOctavesEvaluated();
+		settings.ints[6] = noise.GetCellularDistanceFunction();
+		settings.ints[7] = noise.GetCellularReturnType();
+		noise.GetCellularDistance2Indices(settings.ints[8], settings.ints[9]);
+
+		settings.floats[0] = noise.GetFrequency();
+		settings.floats[1] = noise.GetFractalLacunarity();
+		settings.floats[2] = noise.GetFractalGain();
+		settings.floats[3] = noise.GetFractalBounding();
+		settings.floats[4] = noise.GetCellularJitter();
+
+		return settings;
+	}
+
+	template <typename T>
+	static void InitTable(FReadBuffer& buffer, const T* values, const int32 num, const EPixelFormat format)
+	{
+		buffer.Release();
+		buffer.Initialize(sizeof(T), num, format, BUF_Static);
+
+		void* data = RHILockVertexBuffer(buffer.Buffer, 0, buffer.NumBytes, RLM_WriteOnly);
+		FMemory::Memcpy(data, values, buffer.NumBytes);
+		RHIUnlockVertexBuffer(buffer.Buffer);
+	}
+
+	static void InitTable(FReadBuffer& buffer, const FN_DECIMAL* table, const int32 num)
+	{
+		// FN_DECIMAL may be double, the shader only works with floats
+		TArray<float> values;
+		values.SetNumUninitialized(num);
+
+		for (int32 i = 0; i < num; i++)
+		{
+			values[i] = float(table[i]);
+		}
+
+		InitTable(buffer, values.GetData(), num, PF_R32_FLOAT);
+	}
+
+	/**
+	* Returns the values of a VM input for the whole chunk, the batch kernels reading the positions of every particle at once.
+	* Registers are read in place, constants are expanded to scratch first
+	*/
+	static const float* GetInputValues(VectorVM::FExternalFuncInputHandler<float>& input, float* scratch, const int32 numInstances)
+	{
+		if (!input.IsConstant())
+		{
+			return input.GetDest();
+		}
+
+		const float value = input.Get();
+
+		for (int32 i = 0; i < numInstances; i++)
+		{
+			scratch[i] = value;
+		}
+
+		return scratch;
+	}
+}
+
+/** Render thread copy of the settings and tables of a data interface */
+struct FNiagaraDataInterfaceProxyFastNoise : public FNiagaraDataInterfaceProxy
+{
+	virtual ~FNiagaraDataInterfaceProxyFastNoise()
+	{
+		for (FReadBuffer& table : tables)
+		{
+			table.Release();
+		}
+	}
+
+	// The settings are the same for every instance of the system
+	virtual int32 PerInstanceDataPassedToRenderThreadSize() const override { return 0; }
+	virtual void ConsumePerInstanceDataFromGameThread(void* perInstanceData, const FNiagaraSystemInstanceID& instance) override {}
+
+	void Update_RenderThread(const FastNoiseNiagara::FGPUSettings& newSettings)
+	{
+		using namespace FastNoiseNiagara;
+
+		check(IsInRenderingThread());
+
+		if (newSettings.perm != settings.perm)
+		{
+			InitTable(tables[0], newSettings.perm.GetData(), newSettings.perm.Num(), PF_R32_UINT);
+			InitTable(tables[1], newSettings.perm12.GetData(), newSettings.perm12.Num(), PF_R32_UINT);
+		}
+
+		if (tables[NumPermutationTables].NumBytes == 0)
+		{
+			const FastNoise::LookupTables& lookupTables = FastNoise::GetLookupTables();
+			InitTable(tables[2], lookupTables.gradX, 12);
+			InitTable(tables[3], lookupTables.gradY, 12);
+			InitTable(tables[4], lookupTables.gradZ, 12);
+			InitTable(tables[5], lookupTables.valLut, 256);
+			InitTable(tables[6], lookupTables.cell2DX, 256);
+			InitTable(tables[7], lookupTables.cell2DY, 256);
+			InitTable(tables[8], lookupTables.cell3DX, 256);
+			InitTable(tables[9], lookupTables.cell3DY, 256);
+			InitTable(tables[10], lookupTables.cell3DZ, 256);
+		}
+
+		settings = newSettings;
+	}
+
+	FReadBuffer tables[FastNoiseNiagara::NumTables];
+	FastNoiseNiagara::FGPUSettings settings;
+};
+
+struct FNiagaraDataInterfaceParametersCS_FastNoise : public FNiagaraDataInterfaceParametersCS
+{
+	DECLARE_TYPE_LAYOUT(FNiagaraDataInterfaceParametersCS_FastNoise, NonVirtual);
+
+public:
+
+	void Bind(const FNiagaraDataInterfaceGPUParamInfo& paramInfo, const FShaderParameterMap& parameterMap)
+	{
+		using namespace FastNoiseNiagara;
+
+		for (int32 i = 0; i < NumTables; i++)
+		{
+			tableParams[i].Bind(parameterMap, *GetParameterName(TableNames[i], paramInfo));
+		}
+
+		for (int32 i = 0; i < NumIntSettings; i++)
+		{
+			intParams[i].Bind(parameterMap, *GetParameterName(IntSettingNames[i], paramInfo));
+		}
+
+		for (int32 i = 0; i < NumFloatSettings; i++)
+		{
+			floatParams[i].Bind(parameterMap, *GetParameterName(FloatSettingNames[i], paramInfo));
+		}
+	}
+
+	void Set(FRHICommandList& RHICmdList, const FNiagaraDataInterfaceSetArgs& context) const
+	{
+		using namespace FastNoiseNiagara;
+
+		check(IsInRenderingThread());
+
+		FRHIComputeShader* computeShader = RHICmdList.GetBoundComputeShader();
+		const FNiagaraDataInterfaceProxyFastNoise* proxy = static_cast<const FNiagaraDataInterfaceProxyFastNoise*>(context.DataInterface);
+
+		for (int32 i = 0; i < NumTables; i++)
+		{
+			SetSRVParameter(RHICmdList, computeShader, tableParams[i], proxy->tables[i].SRV);
+		}
+
+		for (int32 i = 0; i < NumIntSettings; i++)
+		{
+			SetShaderValue(RHICmdList, computeShader, intParams[i], proxy->settings.ints[i]);
+		}
+
+		for (int32 i = 0; i < NumFloatSettings; i++)
+		{
+			SetShaderValue(RHICmdList, computeShader, floatParams[i], proxy->settings.floats[i]);
+		}
+	}
+
+	/** Same name as FN(name) in the HLSL of GetParameterDefinitionHLSL(...) */
+	static FString GetParameterName(const TCHAR* name, const FNiagaraDataInterfaceGPUParamInfo& paramInfo)
+	{
+		return FString(name) + TEXT("_") + paramInfo.DataInterfaceHLSLSymbol;
+	}
+
+private:
+
+	LAYOUT_ARRAY(FShaderResourceParameter, tableParams, FastNoiseNiagara::NumTables);
+	LAYOUT_ARRAY(FShaderParameter, intParams, FastNoiseNiagara::NumIntSettings);
+	LAYOUT_ARRAY(FShaderParameter, floatParams, FastNoiseNiagara::NumFloatSettings);
+};
+
+IMPLEMENT_TYPE_LAYOUT(FNiagaraDataInterfaceParametersCS_FastNoise);
+
+IMPLEMENT_NIAGARA_DI_PARAMETER(UNiagaraDataInterfaceFastNoise, FNiagaraDataInterfaceParametersCS_FastNoise);
+
+UNiagaraDataInterfaceFastNoise::UNiagaraDataInterfaceFastNoise(const FObjectInitializer& objectInitializer)
+	: Super(objectInitializer)
+{
+	Proxy.Reset(new FNiagaraDataInterfaceProxyFastNoise());
+}
+
+void UNiagaraDataInterfaceFastNoise::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		// Can be used as a user parameter and in any script
+		FNiagaraTypeRegistry::Register(FNiagaraTypeDefinition(GetClass()), true, false, false);
+	}
+	else
+	{
+		UpdateNoise();
+	}
+}
+
+void UNiagaraDataInterfaceFastNoise::PostLoad()
+{
+	Super::PostLoad();
+
+	UpdateNoise();
+}
+
+#if WITH_EDITOR
+void UNiagaraDataInterfaceFastNoise::PostEditChangeProperty(FPropertyChangedEvent& propertyChangedEvent)
+{
+	Super::PostEditChangeProperty(propertyChangedEvent);
+
+	UpdateNoise();
+}
+#endif
+
+void UNiagaraDataInterfaceFastNoise::GetFunctions(TArray<FNiagaraFunctionSignature>& outFunctions)
+{
+	FNiagaraFunctionSignature signature;
+	signature.bMemberFunction = true;
+	signature.bRequiresContext = false;
+	signature.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("FastNoise")));
+	signature.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Value")));
+
+	FNiagaraFunctionSignature& sample2D = outFunctions.Add_GetRef(signature);
+	sample2D.Name = SampleNoise2DName;
+	sample2D.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec2Def(), TEXT("Position")));
+#if WITH_EDITORONLY_DATA
+	sample2D.SetDescription(LOCTEXT("SampleNoise2DDescription", "Returns the same value as GetNoise2D of the Fast Noise wrapper at the position."));
+#endif
+
+	FNiagaraFunctionSignature& sample3D = outFunctions.Add_GetRef(signature);
+	sample3D.Name = SampleNoise3DName;
+	sample3D.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Position")));
+#if WITH_EDITORONLY_DATA
+	sample3D.SetDescription(LOCTEXT("SampleNoise3DDescription", "Returns the same value as GetNoise3D of the Fast Noise wrapper at the position."));
+#endif
+}
+
+void UNiagaraDataInterfaceFastNoise::GetVMExternalFunction(const FVMExternalFunctionBindingInfo& bindingInfo, void* instanceData, FVMExternalFunction& outFunc)
+{
+	if (!noise.IsValid())
+	{
+		UpdateNoise();
+	}
+
+	// The function keeps the snapshot it was bound with, changing the properties rebinds the functions
+	const TSharedRef<const FastNoise, ESPMode::ThreadSafe> boundNoise = noise.ToSharedRef();
+
+	if (bindingInfo.Name == SampleNoise2DName && bindingInfo.GetNumInputs() == 2 && bindingInfo.GetNumOutputs() == 1)
+	{
+		outFunc = FVMExternalFunction::CreateLambda([boundNoise](FVectorVMContext& context) { SampleNoise2D(*boundNoise, context); });
+	}
+	else if (bindingInfo.Name == SampleNoise3DName && bindingInfo.GetNumInputs() == 3 && bindingInfo.GetNumOutputs() == 1)
+	{
+		outFunc = FVMExternalFunction::CreateLambda([boundNoise](FVectorVMContext& context) { SampleNoise3D(*boundNoise, context); });
+	}
+	else
+	{
+		UE_LOG(LogFastNoiseNiagara, Error, TEXT("Couldn't bind %s with %d inputs and %d outputs"), *bindingInfo.Name.ToString(), bindingInfo.GetNumInputs(), bindingInfo.GetNumOutputs());
+	}
+}
+
+bool UNiagaraDataInterfaceFastNoise::Equals(const UNiagaraDataInterface* other) const
+{
+	if (!Super::Equals(other))
+	{
+		return false;
+	}
+
+	const UNiagaraDataInterfaceFastNoise* otherNoise = CastChecked<const UNiagaraDataInterfaceFastNoise>(other);
+
+	return otherNoise->settings == settings;
+}
+
+bool UNiagaraDataInterfaceFastNoise::CopyToInternal(UNiagaraDataInterface* destination) const
+{
+	if (!Super::CopyToInternal(destination))
+	{
+		return false;
+	}
+
+	UNiagaraDataInterfaceFastNoise* destinationNoise = CastChecked<UNiagaraDataInterfaceFastNoise>(destination);
+	destinationNoise->settings = settings;
+	destinationNoise->UpdateNoise();
+
+	return true;
+}
+
+#if WITH_EDITORONLY_DATA
+bool UNiagaraDataInterfaceFastNoise::AppendCompileHash(FNiagaraCompileHashVisitor* visitor) const
+{
+	if (!Super::AppendCompileHash(visitor))
+	{
+		return false;
+	}
+
+	// The generated HLSL includes the noise functions, changing them has to recompile the emitters
+	visitor->UpdateString(TEXT("FastNoiseCommonHLSLSource"), GetShaderFileHash(TEXT("/FastNoise/FastNoiseCommon.ush"), EShaderPlatform::SP_PCD3D_SM5).ToString());
+	return true;
+}
+
+void UNiagaraDataInterfaceFastNoise::GetParameterDefinitionHLSL(const FNiagaraDataInterfaceGPUParamInfo& paramInfo, FString& outHLSL)
+{
+	using namespace FastNoiseNiagara;
+
+	const FString& symbol = paramInfo.DataInterfaceHLSLSymbol;
+
+	for (int32 i = 0; i < NumTables; i++)
+	{
+		outHLSL += FString::Printf(TEXT("Buffer<%s> %s_%s;\n"), i < NumPermutationTables ? TEXT("uint") : TEXT("float"), TableNames[i], *symbol);
+	}
+
+	for (int32 i = 0; i < NumIntSettings; i++)
+	{
+		outHLSL += FString::Printf(TEXT("int %s_%s;\n"), IntSettingNames[i], *symbol);
+	}
+
+	for (int32 i = 0; i < NumFloatSettings; i++)
+	{
+		outHLSL += FString::Printf(TEXT("float %s_%s;\n"), FloatSettingNames[i], *symbol);
+	}
+
+	// Each data interface includes its own copy of the functions reading its parameters
+	outHLSL += FString::Printf(TEXT("#define FN(name) name##_%s\n"), *symbol);
+	outHLSL += TEXT("#include \"/FastNoise/FastNoiseCommon.ush\"\n");
+	outHLSL += TEXT("#undef FN\n");
+}
+
+bool UNiagaraDataInterfaceFastNoise::GetFunctionHLSL(const FNiagaraDataInterfaceGPUParamInfo& paramInfo, const FNiagaraDataInterfaceGeneratedFunction& functionInfo, int functionInstanceIndex, FString& outHLSL)
+{
+	FStringFormatNamedArguments arguments;
+	arguments.Add(TEXT("FunctionName"), functionInfo.InstanceName);
+	arguments.Add(TEXT("Symbol"), paramInfo.DataInterfaceHLSLSymbol);
+
+	// The positions are scaled by the frequency like GetNoise(...)
+	if (functionInfo.DefinitionName == SampleNoise2DName)
+	{
+		outHLSL += FString::Format(TEXT(
+			"void {FunctionName}(float2 In_Position, out float Out_Value)\n"
+			"{\n"
+			"	Out_Value = GetNoise2D_{Symbol}(In_Position.x * Frequency_{Symbol}, In_Position.y * Frequency_{Symbol});\n"
+			"}\n"), arguments);
+		return true;
+	}
+
+	if (functionInfo.DefinitionName == SampleNoise3DName)
+	{
+		outHLSL += FString::Format(TEXT(
+			"void {FunctionName}(float3 In_Position, out float Out_Value)\n"
+			"{\n"
+			"	Out_Value = GetNoise3D_{Symbol}(In_Position.x * Frequency_{Symbol}, In_Position.y * Frequency_{Symbol}, In_Position.z * Frequency_{Symbol});\n"
+			"}\n"), arguments);
+		return true;
+	}
+
+	return false;
+}
+#endif
+
+void UNiagaraDataInterfaceFastNoise::PushToRenderThreadImpl()
+{
+	if (!noise.IsValid())
+	{
+		return;
+	}
+
+	FNiagaraDataInterfaceProxyFastNoise* proxy = GetProxyAs<FNiagaraDataInterfaceProxyFastNoise>();
+
+	ENQUEUE_RENDER_COMMAND(FastNoiseNiagara)([proxy, settings = FastNoiseNiagara::GetGPUSettings(*noise)](FRHICommandListImmediate& RHICmdList)
+	{
+		proxy->Update_RenderThread(settings);
+	});
+}
+
+void UNiagaraDataInterfaceFastNoise::UpdateNoise()
+{
+	noise = FFastNoiseEvaluator(settings).GetSnapshot();
+
+	MarkRenderDataDirty();
+}
+
+void UNiagaraDataInterfaceFastNoise::SampleNoise2D(const FastNoise& noise, FVectorVMContext& context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Niagara);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_Niagara);
+
+	VectorVM::FExternalFuncInputHandler<float> inX(context);
+	VectorVM::FExternalFuncInputHandler<float> inY(context);
+	VectorVM::FExternalFuncRegisterHandler<float> outValue(context);
+
+	// An unused output is a single dummy value, not a register of the whole chunk
+	if (!outValue.IsValid())
+	{
+		return;
+	}
+
+	const int32 numInstances = context.NumInstances;
+
+	FMemMark mark(FMemStack::Get());
+	TArray<float, TMemStackAllocator<>> scratch;
+	scratch.SetNumUninitialized(2 * numInstances);
+
+	const float* x = FastNoiseNiagara::GetInputValues(inX, scratch.GetData(), numInstances);
+	const float* y = FastNoiseNiagara::GetInputValues(inY, scratch.GetData() + numInstances, numInstances);
+
+	noise.FillNoiseSetPoints2D(outValue.GetDest(), x, y, numInstances);
+	FastNoiseStats::AddBatch(noise.GetNoiseType(), numInstances);
+}
+
+void UNiagaraDataInterfaceFastNoise::SampleNoise3D(const FastNoise& noise, FVectorVMContext& context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Niagara);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_Niagara);
+
+	VectorVM::FExternalFuncInputHandler<float> inX(context);
+	VectorVM::FExternalFuncInputHandler<float> inY(context);
+	VectorVM::FExternalFuncInputHandler<float> inZ(context);
+	VectorVM::FExternalFuncRegisterHandler<float> outValue(context);
+
+	if (!outValue.IsValid())
+	{
+		return;
+	}
+
+	const int32 numInstances = context.NumInstances;
+
+	FMemMark mark(FMemStack::Get());
+	TArray<float, TMemStackAllocator<>> scratch;
+	scratch.SetNumUninitialized(3 * numInstances);
+
+	const float* x = FastNoiseNiagara::GetInputValues(inX, scratch.GetData(), numInstances);
+	const float* y = FastNoiseNiagara::GetInputValues(inY, scratch.GetData() + numInstances, numInstances);
+	const float* z = FastNoiseNiagara::GetInputValues(inZ, scratch.GetData() + 2 * numInstances, numInstances);
+
+	noise.FillNoiseSetPoints3D(outValue.GetDest(), x, y, z, numInstances);
+	FastNoiseStats::AddBatch(noise.GetNoiseType(), numInstances);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,95 @@
+// FastNoiseNiagara.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NiagaraDataInterface.h"
+#include "FastNoiseSettings.h"
+#include "FastNoiseNiagara.generated.h"
+
+/**
+ * Niagara data interface sampling FastNoise, e.g. to drive particle forces or colors from the same noise as the world.
+ * CPU emitters sample the whole chunk of particles in one batch with the SSE2 kernels of GetNoise2DBatch/GetNoise3DBatch(...),
+ * GPU emitters run the functions of Shaders/FastNoiseCommon.ush, which match the CPU within floating point tolerance.
+ * White Noise is CPU only and returns 0 on the GPU. As for the compute shader, the project module must map the shader
+ * directory with AddShaderSourceDirectoryMapping(TEXT("/FastNoise"), ...) on startup
+ */
+UCLASS(EditInlineNew, Category = "Fast Noise", meta = (DisplayName = "Fast Noise"))
+class PROJECT_API UNiagaraDataInterfaceFastNoise : public UNiagaraDataInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	UNiagaraDataInterfaceFastNoise(const FObjectInitializer& objectInitializer);
+
+	/** Noise settings. The gradient perturb settings are unused, and NoiseLookup returns 0 as the data interface has no lookup noise */
+	UPROPERTY(EditAnywhere, Category = "Fast Noise", meta = (ShowOnlyInnerProperties))
+	FFastNoiseSettings settings;
+
+	// UObject interface
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& propertyChangedEvent) override;
+#endif
+
+	// UNiagaraDataInterface interface
+	virtual void GetFunctions(TArray<FNiagaraFunctionSignature>& outFunctions) override;
+	virtual void GetVMExternalFunction(const FVMExternalFunctionBindingInfo& bindingInfo, void* instanceData, FVMExternalFunction& outFunc) override;
+	virtual bool Equals(const UNiagaraDataInterface* other) const override;
+	virtual bool CanExecuteOnTarget(ENiagaraSimTarget target) const override { return true; }
+#if WITH_EDITORONLY_DATA
+	virtual bool AppendCompileHash(FNiagaraCompileHashVisitor* visitor) const override;
+	virtual void GetParameterDefinitionHLSL(const FNiagaraDataInterfaceGPUParamInfo& paramInfo, FString& outHLSL) override;
+	virtual bool GetFunctionHLSL(const FNiagaraDataInterfaceGPUParamInfo& paramInfo, const FNiagaraDataInterfaceGeneratedFunction& functionInfo, int functionInstanceIndex, FString& outHLSL) override;
+#endif
+
+	/** Names of the Niagara functions, each taking a position and returning the noise value */
+	static const FName SampleNoise2DName;
+	static const FName SampleNoise3DName;
+
+protected:
+
+	virtual bool CopyToInternal(UNiagaraDataInterface* destination) const override;
+	virtual void PushToRenderThreadImpl() override;
+
+private:
+
+	/** Copies the properties to the snapshot read by the VM and the render thread */
+	void UpdateNoise();
+
+	/** Samples the noise at the positions of a chunk of particles, all of them in one batch */
+	static void SampleNoise2D(const FastNoise& noise, FVectorVMContext& context);
+	static void SampleNoise3D(const FastNoise& noise, FVectorVMContext& context);
+
+	/** Settings sampled by the VM, the bound functions keep the snapshot they were bound with */
+	TSharedPtr<const FastNoise, ESPMode::ThreadSafe> noise;
+};
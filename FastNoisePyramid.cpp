@@ -0,0 +1,183 @@
+// FastNoisePyramid.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoisePyramid.h"
+#include "FastNoiseStats.h"
+
+void UFastNoisePyramid::SetupPyramid(UFastNoiseWrapper* fastNoiseWrapper, const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, const int32 numLevels, const bool bSkipUnresolvedOctaves)
+{
+	bNoiseInitialized = fastNoiseWrapper && fastNoiseWrapper->IsInitialized();
+	snapshot = bNoiseInitialized ? TSharedPtr<const FastNoise, ESPMode::ThreadSafe>(fastNoiseWrapper->GetSnapshot()) : nullptr;
+	const FastNoise noise = snapshot.IsValid() ? *snapshot : FastNoise();
+
+	pyramidOrigin = origin;
+	numSamplesGenerated = 0;
+	numSamplesReused = 0;
+
+	// A level of n samples has a next level of (n - 1) / 2 + 1, down to a level of a single sample
+	const int32 size0X = FMath::Max(sizeX, 0);
+	const int32 size0Y = FMath::Max(sizeY, 0);
+	const int32 maxSize = size0X > 0 && size0Y > 0 ? FMath::Max(size0X, size0Y) : 0;
+	const int32 maxLevels = maxSize > 1 ? FMath::FloorLog2(uint32(maxSize - 1)) + 2 : maxSize;
+
+	levels.Empty();
+	levels.SetNum(FMath::Clamp(numLevels, 0, maxLevels));
+
+	for (int32 level = 0; level < levels.Num(); level++)
+	{
+		FLevel& pyramidLevel = levels[level];
+		pyramidLevel.size = FIntPoint(((size0X - 1) >> level) + 1, ((size0Y - 1) >> level) + 1);
+		pyramidLevel.step = step * float(uint32(1) << level);
+		pyramidLevel.noise = noise;
+
+		if (bSkipUnresolvedOctaves && IsFractal(noise))
+		{
+			const float spacing = FMath::Max(FMath::Abs(pyramidLevel.step.X), FMath::Abs(pyramidLevel.step.Y));
+			pyramidLevel.noise.SetFractalOctaveLimit(GetResolvedOctaves(noise, spacing));
+		}
+	}
+}
+
+bool UFastNoisePyramid::GenerateLevel(const int32 level)
+{
+	if (!levels.IsValidIndex(level))
+	{
+		return false;
+	}
+
+	FLevel& pyramidLevel = levels[level];
+
+	if (pyramidLevel.bReady)
+	{
+		return true;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_GeneratePyramidLevel);
+
+	const int32 numSamples = pyramidLevel.size.X * pyramidLevel.size.Y;
+	pyramidLevel.values.SetNumUninitialized(numSamples);
+	pyramidLevel.bReady = true;
+
+	if (!bNoiseInitialized)
+	{
+		FMemory::Memzero(pyramidLevel.values.GetData(), numSamples * sizeof(float));
+		return true;
+	}
+
+	// The coarse samples only match if they were calculated with the same octaves
+	const FLevel* coarseLevel = levels.IsValidIndex(level + 1) ? &levels[level + 1] : nullptr;
+	const bool bReuse = coarseLevel && coarseLevel->bReady && (!IsFractal(pyramidLevel.noise) || coarseLevel->noise.GetFractalOctavesEvaluated() == pyramidLevel.noise.GetFractalOctavesEvaluated());
+
+	if (bReuse)
+	{
+		pyramidLevel.noise.FillRefinedNoiseSet2D(pyramidLevel.values.GetData(), coarseLevel->values.GetData(), pyramidOrigin.X, pyramidOrigin.Y, pyramidLevel.size.X, pyramidLevel.size.Y, pyramidLevel.step.X, pyramidLevel.step.Y);
+
+		const int32 numReused = coarseLevel->size.X * coarseLevel->size.Y;
+		numSamplesReused += numReused;
+		numSamplesGenerated += numSamples - numReused;
+		FastNoiseStats::AddSamples(pyramidLevel.noise.GetNoiseType(), numSamples - numReused);
+	}
+	else
+	{
+		pyramidLevel.noise.FillNoiseSet2D(pyramidLevel.values.GetData(), pyramidOrigin.X, pyramidOrigin.Y, pyramidLevel.size.X, pyramidLevel.size.Y, pyramidLevel.step.X, pyramidLevel.step.Y);
+
+		numSamplesGenerated += numSamples;
+		FastNoiseStats::AddSamples(pyramidLevel.noise.GetNoiseType(), numSamples);
+	}
+
+	return true;
+}
+
+bool UFastNoisePyramid::GenerateLevelsDownTo(const int32 level)
+{
+	if (!levels.IsValidIndex(level))
+	{
+		return false;
+	}
+
+	for (int32 coarseLevel = levels.Num() - 1; coarseLevel >= level; coarseLevel--)
+	{
+		GenerateLevel(coarseLevel);
+	}
+
+	return true;
+}
+
+void UFastNoisePyramid::ReleaseLevel(const int32 level)
+{
+	if (levels.IsValidIndex(level))
+	{
+		levels[level].values.Empty();
+		levels[level].bReady = false;
+	}
+}
+
+bool UFastNoisePyramid::CopyLevelNoise(const int32 level, TArray<float>& outNoise) const
+{
+	const TArrayView<const float> noise = GetLevelNoise(level);
+	outNoise = TArray<float>(noise.GetData(), noise.Num());
+
+	return noise.Num() > 0;
+}
+
+TArrayView<const float> UFastNoisePyramid::GetLevelNoise(const int32 level) const
+{
+	return IsLevelReady(level) ? TArrayView<const float>(levels[level].values) : TArrayView<const float>();
+}
+
+int32 UFastNoisePyramid::GetResolvedOctaves(const FastNoise& noise, const float spacing)
+{
+	// Octave n has a frequency of frequency * lacunarity^n, it aliases once the samples are more than half a feature apart
+	const float lacunarity = noise.GetFractalLacunarity();
+	float octaveFrequency = FMath::Abs(noise.GetFrequency()) * lacunarity;
+	int32 octaves = 1;
+
+	while (octaves < noise.GetFractalOctaves() && octaveFrequency * spacing <= 0.5f)
+	{
+		octaveFrequency *= lacunarity;
+		octaves++;
+	}
+
+	return octaves;
+}
+
+bool UFastNoisePyramid::IsFractal(const FastNoise& noise)
+{
+	switch (noise.GetNoiseType())
+	{
+	case FastNoise::ValueFractal:
+	case FastNoise::PerlinFractal:
+	case FastNoise::SimplexFractal:
+	case FastNoise::CubicFractal:
+		return true;
+	default:
+		return false;
+	}
+}
@@ -0,0 +1,155 @@
+// FastNoisePyramid.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Containers/ArrayView.h"
+#include "FastNoiseWrapper.h"
+#include "FastNoisePyramid.generated.h"
+
+/**
+ * Mip-style pyramid of noise grids over one region, e.g. the heightfield of a terrain section from far away to close up.
+ * Level 0 is the finest grid and every next level doubles the step, so distant LODs can be generated first at a fraction of the cost
+ * and the finer levels on demand. A level generated right after the next coarser one copies the coarse samples lying on its
+ * lattice instead of calculating them, a quarter of its samples. Levels can also skip the fractal octaves finer than their
+ * sample spacing, those levels have less detail than GetNoise2DGrid(...) but don't alias, the others hold the same values.
+ * The settings are copied by SetupPyramid(...), changing them afterwards doesn't affect the pyramid
+ */
+UCLASS(BlueprintType)
+class PROJECT_API UFastNoisePyramid : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	* Set the pyramid properties and copy the noise settings, releasing every level
+	*
+	* @param fastNoiseWrapper			- the noise settings, the levels of an uninitialized wrapper are set to 0
+	* @param origin						- the x and y values of the first sample of every level
+	* @param step						- the distance between two consecutive samples of level 0 on each axis, doubled at every level
+	* @param sizeX						- the number of samples of level 0 along x, level n having ((sizeX - 1) >> n) + 1. Sizes of 2^n + 1 make every level cover the same region
+	* @param sizeY						- the number of samples of level 0 along y, level n having ((sizeY - 1) >> n) + 1
+	* @param numLevels					- the number of levels, down to a level of a single sample at most. Default value: 4
+	* @param bSkipUnresolvedOctaves		- whether the fractal octaves with features smaller than two samples of a level are skipped by that level. Default value: true
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Pyramid")
+	void SetupPyramid(UFastNoiseWrapper* fastNoiseWrapper, const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, const int32 numLevels = 4, const bool bSkipUnresolvedOctaves = true);
+
+	/**
+	* Generates a level if it isn't generated yet, reusing the next coarser level if it is generated and evaluates the same octaves
+	*
+	* @return false if the level doesn't exist
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Pyramid")
+	bool GenerateLevel(const int32 level);
+
+	/**
+	* Generates every level from the coarsest one down to level, e.g. to bring in a section from far away.
+	* Each level is available before the finer ones and reuses the previous one when they evaluate the same octaves
+	*
+	* @return false if the level doesn't exist
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Pyramid")
+	bool GenerateLevelsDownTo(const int32 level);
+
+	/** Frees the values of a level, e.g. the finer levels once the player moved away */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Pyramid")
+	void ReleaseLevel(const int32 level);
+
+	/** Returns whether a level is generated */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Pyramid")
+	bool IsLevelReady(const int32 level) const { return levels.IsValidIndex(level) && levels[level].bReady; }
+
+	/**
+	* Copies the values of a generated level
+	*
+	* @param level		- the level, 0 being the finest
+	* @param outNoise	- the values, sample (i, j) being at index i + j * GetLevelSize(level).X and at origin + (i, j) * GetLevelStep(level)
+	* @return whether the level is generated
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Pyramid")
+	bool CopyLevelNoise(const int32 level, TArray<float>& outNoise) const;
+
+	/** Returns the values of a generated level, laid out like CopyLevelNoise(...), empty if it isn't. Valid until the level is released */
+	TArrayView<const float> GetLevelNoise(const int32 level) const;
+
+	/** Returns the number of levels */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Pyramid")
+	int32 GetNumLevels() const { return levels.Num(); }
+
+	/** Returns the number of samples of a level on each axis */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Pyramid")
+	FIntPoint GetLevelSize(const int32 level) const { return levels.IsValidIndex(level) ? levels[level].size : FIntPoint::ZeroValue; }
+
+	/** Returns the distance between two consecutive samples of a level on each axis */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Pyramid")
+	FVector2D GetLevelStep(const int32 level) const { return levels.IsValidIndex(level) ? levels[level].step : FVector2D::ZeroVector; }
+
+	/** Returns the number of fractal octaves a level evaluates */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Pyramid")
+	int32 GetLevelOctaves(const int32 level) const { return levels.IsValidIndex(level) ? levels[level].noise.GetFractalOctavesEvaluated() : 0; }
+
+	/** Returns the number of samples calculated since the pyramid was set up */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Pyramid")
+	int64 GetNumSamplesGenerated() const { return numSamplesGenerated; }
+
+	/** Returns the number of samples copied from a coarser level since the pyramid was set up */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Pyramid")
+	int64 GetNumSamplesReused() const { return numSamplesReused; }
+
+private:
+
+	struct FLevel
+	{
+		/** Settings of the level, with the octave limit of its sample spacing */
+		FastNoise noise;
+		TArray<float> values;
+		FIntPoint size = FIntPoint::ZeroValue;
+		FVector2D step = FVector2D::ZeroVector;
+		bool bReady = false;
+	};
+
+	/** Returns the number of octaves whose features are at least two samples apart, assuming features about 1 / frequency wide */
+	static int32 GetResolvedOctaves(const FastNoise& noise, const float spacing);
+
+	/** Whether the noise type sums octaves, the octave limit doesn't change the other types */
+	static bool IsFractal(const FastNoise& noise);
+
+	TArray<FLevel> levels;
+	/** Snapshot the levels were copied from, it keeps the cellular lookup noise the copies point to alive */
+	TSharedPtr<const FastNoise, ESPMode::ThreadSafe> snapshot;
+	FVector2D pyramidOrigin = FVector2D::ZeroVector;
+	bool bNoiseInitialized = false;
+
+	int64 numSamplesGenerated = 0;
+	int64 numSamplesReused = 0;
+};
@@ -0,0 +1,237 @@
+// FastNoiseSettings.cpp
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#include "FastNoiseSettings.h"
+#include "Hash/CityHash.h"
+#include "FastNoiseStats.h"
+
+void FFastNoiseSettings::ApplyTo(FastNoise& noise) const
+{
+	noise.SetNoiseType(FastNoiseSettings::ToFastNoise(noiseType));
+	noise.SetSeed(seed);
+	noise.SetFrequency(frequency);
+	noise.SetInterp(FastNoiseSettings::ToFastNoise(interp));
+	noise.SetIndexMode(FastNoiseSettings::ToFastNoise(indexMode));
+	noise.SetFractalType(FastNoiseSettings::ToFastNoise(fractalType));
+	noise.SetFractalOctaves(octaves);
+	noise.SetFractalLacunarity(lacunarity);
+	noise.SetFractalGain(gain);
+	noise.SetFractalAmplitudeThreshold(fractalAmplitudeThreshold);
+	noise.SetCellularJitter(cellularJitter);
+	noise.SetCellularDistanceFunction(FastNoiseSettings::ToFastNoise(cellularDistanceFunction));
+	noise.SetCellularReturnType(FastNoiseSettings::ToFastNoise(cellularReturnType));
+	noise.SetGradientPerturbAmp(gradientPerturbAmp);
+}
+
+FFastNoiseSettings FFastNoiseSettings::FromFastNoise(const FastNoise& noise)
+{
+	FFastNoiseSettings settings;
+	settings.noiseType = FastNoiseSettings::FromFastNoise(noise.GetNoiseType());
+	settings.seed = noise.GetSeed();
+	settings.frequency = noise.GetFrequency();
+	settings.interp = FastNoiseSettings::FromFastNoise(noise.GetInterp());
+	settings.indexMode = FastNoiseSettings::FromFastNoise(noise.GetIndexMode());
+	settings.fractalType = FastNoiseSettings::FromFastNoise(noise.GetFractalType());
+	settings.octaves = noise.GetFractalOctaves();
+	settings.lacunarity = noise.GetFractalLacunarity();
+	settings.gain = noise.GetFractalGain();
+	settings.fractalAmplitudeThreshold = noise.GetFractalAmplitudeThreshold();
+	settings.cellularJitter = noise.GetCellularJitter();
+	settings.cellularDistanceFunction = FastNoiseSettings::FromFastNoise(noise.GetCellularDistanceFunction());
+	settings.cellularReturnType = FastNoiseSettings::FromFastNoise(noise.GetCellularReturnType());
+	settings.gradientPerturbAmp = noise.GetGradientPerturbAmp();
+
+	return settings;
+}
+
+bool FFastNoiseSettings::operator==(const FFastNoiseSettings& other) const
+{
+	return StaticStruct()->CompareScriptStruct(this, &other, 0);
+}
+
+namespace FastNoiseEvaluator
+{
+	static TSharedRef<const FastNoise, ESPMode::ThreadSafe> MakeNoise(const FFastNoiseSettings& settings, const TSharedPtr<const FastNoise, ESPMode::ThreadSafe>& cellularNoiseLookup)
+	{
+		FastNoise noise;
+		settings.ApplyTo(noise);
+		noise.SetCellularNoiseLookup(cellularNoiseLookup.Get());
+
+		return FFastNoiseEvaluator::MakeSnapshot(noise, cellularNoiseLookup);
+	}
+}
+
+FFastNoiseEvaluator::FFastNoiseEvaluator(const FFastNoiseSettings& settings, const TSharedPtr<const FastNoise, ESPMode::ThreadSafe>& cellularNoiseLookup)
+	: FFastNoiseEvaluator(FastNoiseEvaluator::MakeNoise(settings, cellularNoiseLookup))
+{
+}
+
+FFastNoiseEvaluator::FFastNoiseEvaluator(const TSharedRef<const FastNoise, ESPMode::ThreadSafe>& snapshot)
+	: noise(snapshot)
+	, noiseFunc2D(snapshot->GetNoiseFunc2D())
+	, noiseFunc3D(snapshot->GetNoiseFunc3D())
+	, settingsHash(HashSettings(*snapshot))
+{
+}
+
+bool FFastNoiseEvaluator::FillNoise2DGrid(const FVector2D& origin, const FVector2D& step, const int32 sizeX, const int32 sizeY, TArrayView<float> outNoise) const
+{
+	const int32 numSamples = FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0);
+
+	if (outNoise.Num() < numSamples)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_EvaluatorFillNoise2DGrid);
+	FastNoiseStats::AddSamples(noise->GetNoiseType(), numSamples);
+
+	noise->FillNoiseSet2D(outNoise.GetData(), origin.X, origin.Y, sizeX, sizeY, step.X, step.Y);
+	return true;
+}
+
+bool FFastNoiseEvaluator::FillNoise3DGrid(const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArrayView<float> outNoise) const
+{
+	const int32 numSamples = FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0);
+
+	if (outNoise.Num() < numSamples)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_EvaluatorFillNoise3DGrid);
+	FastNoiseStats::AddSamples(noise->GetNoiseType(), numSamples);
+
+	noise->FillNoiseSet3D(outNoise.GetData(), origin.X, origin.Y, origin.Z, sizeX, sizeY, sizeZ, step.X, step.Y, step.Z);
+	return true;
+}
+
+bool FFastNoiseEvaluator::GetNoise2DBatch(TArrayView<const FVector2D> positions, TArrayView<float> outNoise) const
+{
+	static_assert(sizeof(FVector2D) == 2 * sizeof(float), "The positions are read as interleaved floats");
+
+	if (outNoise.Num() < positions.Num())
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Batch);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_EvaluatorGetNoise2DBatch);
+	FastNoiseStats::AddBatch(noise->GetNoiseType(), positions.Num());
+
+	const float* x = reinterpret_cast<const float*>(positions.GetData());
+	noise->FillNoiseSetPoints2D(outNoise.GetData(), x, x + 1, positions.Num(), 2);
+	return true;
+}
+
+bool FFastNoiseEvaluator::GetNoise3DBatch(TArrayView<const FVector> positions, TArrayView<float> outNoise) const
+{
+	static_assert(sizeof(FVector) == 3 * sizeof(float), "The positions are read as interleaved floats");
+
+	if (outNoise.Num() < positions.Num())
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Batch);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_EvaluatorGetNoise3DBatch);
+	FastNoiseStats::AddBatch(noise->GetNoiseType(), positions.Num());
+
+	const float* x = reinterpret_cast<const float*>(positions.GetData());
+	noise->FillNoiseSetPoints3D(outNoise.GetData(), x, x + 1, x + 2, positions.Num(), 3);
+	return true;
+}
+
+bool FFastNoiseEvaluator::GetNoise2DBatch(TArrayView<const float> x, TArrayView<const float> y, TArrayView<float> outNoise) const
+{
+	if (y.Num() != x.Num() || outNoise.Num() < x.Num())
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Batch);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_EvaluatorGetNoise2DBatch);
+	FastNoiseStats::AddBatch(noise->GetNoiseType(), x.Num());
+
+	noise->FillNoiseSetPoints2D(outNoise.GetData(), x.GetData(), y.GetData(), x.Num());
+	return true;
+}
+
+bool FFastNoiseEvaluator::GetNoise3DBatch(TArrayView<const float> x, TArrayView<const float> y, TArrayView<const float> z, TArrayView<float> outNoise) const
+{
+	if (y.Num() != x.Num() || z.Num() != x.Num() || outNoise.Num() < x.Num())
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FastNoise_Batch);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_EvaluatorGetNoise3DBatch);
+	FastNoiseStats::AddBatch(noise->GetNoiseType(), x.Num());
+
+	noise->FillNoiseSetPoints3D(outNoise.GetData(), x.GetData(), y.GetData(), z.GetData(), x.Num());
+	return true;
+}
+
+TSharedRef<const FastNoise, ESPMode::ThreadSafe> FFastNoiseEvaluator::MakeSnapshot(const FastNoise& noise, const TSharedPtr<const FastNoise, ESPMode::ThreadSafe>& cellularNoiseLookup)
+{
+	return MakeShareable(new FastNoise(noise), [cellularNoiseLookup](FastNoise* copy) { delete copy; });
+}
+
+uint64 FFastNoiseEvaluator::HashSettings(const FastNoise& noise)
+{
+	struct FSettings
+	{
+		int32 seed, indexMode, noiseType, interp, fractalType, octaves, distanceFunction, returnType, distanceIndex0, distanceIndex1;
+		float frequency, lacunarity, gain, amplitudeThreshold, cellularJitter;
+		uint64 cellularNoiseLookup;
+	};
+
+	// Zeroed first so the padding doesn't change the hash
+	FSettings settings;
+	FMemory::Memzero(settings);
+	settings.seed = noise.GetSeed();
+	settings.indexMode = noise.GetIndexMode();
+	settings.noiseType = noise.GetNoiseType();
+	settings.interp = noise.GetInterp();
+	settings.fractalType = noise.GetFractalType();
+	settings.octaves = noise.GetFractalOctaves();
+	settings.distanceFunction = noise.GetCellularDistanceFunction();
+	settings.returnType = noise.GetCellularReturnType();
+	noise.GetCellularDistance2Indices(settings.distanceIndex0, settings.distanceIndex1);
+	settings.frequency = noise.GetFrequency();
+	settings.lacunarity = noise.GetFractalLacunarity();
+	settings.gain = noise.GetFractalGain();
+	settings.amplitudeThreshold = noise.GetFractalAmplitudeThreshold();
+	settings.cellularJitter = noise.GetCellularJitter();
+	settings.cellularNoiseLookup = noise.GetCellularNoiseLookup() ? HashSettings(*noise.GetCellularNoiseLookup()) : 0;
+
+	return CityHash64(reinterpret_cast<const char*>(&settings), sizeof(settings));
+}
@@ -0,0 +1,245 @@
+// FastNoiseSettings.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Containers/ArrayView.h"
+#include "FastNoise.h"
+#include "FastNoiseSettings.generated.h"
+
+// Fast Noise UE4 enum wrappers
+UENUM(BlueprintType) enum class EFastNoise_NoiseType				: uint8 { Value, ValueFractal, Perlin, PerlinFractal, Simplex, SimplexFractal, Cellular, WhiteNoise, Cubic, CubicFractal };
+UENUM(BlueprintType) enum class EFastNoise_Interp					: uint8 { Linear, Hermite, Quintic };
+UENUM(BlueprintType) enum class EFastNoise_FractalType				: uint8 { FBM, Billow, RigidMulti };
+UENUM(BlueprintType) enum class EFastNoise_CellularDistanceFunction	: uint8 { Euclidean, Manhattan, Natural };
+UENUM(BlueprintType) enum class EFastNoise_CellularReturnType		: uint8 { CellValue, Distance, Distance2, Distance2Add, Distance2Sub, Distance2Mul, Distance2Div, NoiseLookup };
+UENUM(BlueprintType) enum class EFastNoise_IndexMode				: uint8 { PermutationTable, IntegerHash };
+
+/**
+ * Conversions between the enum wrappers and the FastNoise enums, values out of range converting to the FastNoise defaults.
+ * The enums have the same order as FastNoise, except the cellular return types where NoiseLookup comes last
+ */
+namespace FastNoiseSettings
+{
+	static_assert(int32(EFastNoise_NoiseType::CubicFractal) == FastNoise::CubicFractal, "The noise types must have the order of FastNoise");
+	static_assert(int32(EFastNoise_Interp::Quintic) == FastNoise::Quintic, "The interpolations must have the order of FastNoise");
+	static_assert(int32(EFastNoise_FractalType::RigidMulti) == FastNoise::RigidMulti, "The fractal types must have the order of FastNoise");
+	static_assert(int32(EFastNoise_CellularDistanceFunction::Natural) == FastNoise::Natural, "The distance functions must have the order of FastNoise");
+	static_assert(int32(EFastNoise_CellularReturnType::Distance2Div) + 1 == FastNoise::Distance2Div, "The cellular return types must follow FastNoise after NoiseLookup");
+	static_assert(int32(EFastNoise_IndexMode::IntegerHash) == FastNoise::IntegerHash, "The index modes must have the order of FastNoise");
+
+	inline FastNoise::NoiseType ToFastNoise(const EFastNoise_NoiseType noiseType) { return noiseType <= EFastNoise_NoiseType::CubicFractal ? FastNoise::NoiseType(noiseType) : FastNoise::Simplex; }
+	inline FastNoise::Interp ToFastNoise(const EFastNoise_Interp interp) { return interp <= EFastNoise_Interp::Quintic ? FastNoise::Interp(interp) : FastNoise::Quintic; }
+	inline FastNoise::FractalType ToFastNoise(const EFastNoise_FractalType fractalType) { return fractalType <= EFastNoise_FractalType::RigidMulti ? FastNoise::FractalType(fractalType) : FastNoise::FBM; }
+	inline FastNoise::CellularDistanceFunction ToFastNoise(const EFastNoise_CellularDistanceFunction distanceFunction) { return distanceFunction <= EFastNoise_CellularDistanceFunction::Natural ? FastNoise::CellularDistanceFunction(distanceFunction) : FastNoise::Euclidean; }
+	inline FastNoise::IndexMode ToFastNoise(const EFastNoise_IndexMode indexMode) { return indexMode <= EFastNoise_IndexMode::IntegerHash ? FastNoise::IndexMode(indexMode) : FastNoise::PermutationTable; }
+
+	inline FastNoise::CellularReturnType ToFastNoise(const EFastNoise_CellularReturnType returnType)
+	{
+		if (returnType == EFastNoise_CellularReturnType::NoiseLookup)
+		{
+			return FastNoise::NoiseLookup;
+		}
+
+		return returnType > EFastNoise_CellularReturnType::CellValue && returnType <= EFastNoise_CellularReturnType::Distance2Div ? FastNoise::CellularReturnType(int32(returnType) + 1) : FastNoise::CellValue;
+	}
+
+	inline EFastNoise_NoiseType FromFastNoise(const FastNoise::NoiseType noiseType) { return EFastNoise_NoiseType(noiseType); }
+	inline EFastNoise_Interp FromFastNoise(const FastNoise::Interp interp) { return EFastNoise_Interp(interp); }
+	inline EFastNoise_FractalType FromFastNoise(const FastNoise::FractalType fractalType) { return EFastNoise_FractalType(fractalType); }
+	inline EFastNoise_CellularDistanceFunction FromFastNoise(const FastNoise::CellularDistanceFunction distanceFunction) { return EFastNoise_CellularDistanceFunction(distanceFunction); }
+	inline EFastNoise_IndexMode FromFastNoise(const FastNoise::IndexMode indexMode) { return EFastNoise_IndexMode(indexMode); }
+
+	inline EFastNoise_CellularReturnType FromFastNoise(const FastNoise::CellularReturnType returnType)
+	{
+		switch (returnType)
+		{
+		case FastNoise::CellValue:		return EFastNoise_CellularReturnType::CellValue;
+		case FastNoise::NoiseLookup:	return EFastNoise_CellularReturnType::NoiseLookup;
+		default:						return EFastNoise_CellularReturnType(int32(returnType) - 1);
+		}
+	}
+}
+
+/**
+ * Value type holding every setting of the noise, e.g. stored in data assets or copied into generation jobs.
+ * The defaults are the ones of SetupFastNoise(...). The cellular noise lookup is a separate noise and isn't part of the settings
+ */
+USTRUCT(BlueprintType)
+struct PROJECT_API FFastNoiseSettings
+{
+	GENERATED_BODY()
+
+	/** Noise return type of GetNoise(...). Default: Simplex */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|General settings")
+	EFastNoise_NoiseType noiseType = EFastNoise_NoiseType::Simplex;
+
+	/** Seed used for all noise types. Default: 1337 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|General settings")
+	int32 seed = 1337;
+
+	/** Frequency for all noise types, except White Noise. Default: 0.01 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|General settings")
+	float frequency = 0.01f;
+
+	/** Interpolation method used to smooth between noise values in Value and Perlin Noise. Default: Quintic */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|General settings")
+	EFastNoise_Interp interp = EFastNoise_Interp::Quintic;
+
+	/** How lattice coordinates are hashed into gradient and value indices. Default: PermutationTable */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|General settings")
+	EFastNoise_IndexMode indexMode = EFastNoise_IndexMode::PermutationTable;
+
+	/** Method for combining octaves in all fractal noise types. Default: FBM */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Fractal settings")
+	EFastNoise_FractalType fractalType = EFastNoise_FractalType::FBM;
+
+	/** Octave count for all fractal noise types. Default: 3 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Fractal settings", meta = (ClampMin = "1"))
+	int32 octaves = 3;
+
+	/** Octave lacunarity for all fractal noise types. Default: 2.0 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Fractal settings")
+	float lacunarity = 2.0f;
+
+	/** Octave gain for all fractal noise types. Default: 0.5 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Fractal settings")
+	float gain = 0.5f;
+
+	/** Largest change to the noise allowed by skipping the highest octaves, 0 evaluates every octave. Default: 0.0 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Fractal settings", meta = (ClampMin = "0.0"))
+	float fractalAmplitudeThreshold = 0.0f;
+
+	/** Maximum distance a cellular point can move from its grid position. Default: 0.45 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Cellular settings")
+	float cellularJitter = 0.45f;
+
+	/** Distance function used in cellular noise calculations. Default: Euclidean */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Cellular settings")
+	EFastNoise_CellularDistanceFunction cellularDistanceFunction = EFastNoise_CellularDistanceFunction::Euclidean;
+
+	/** Return type from cellular noise calculations, NoiseLookup needs a cellular noise lookup and returns 0 without one. Default: CellValue */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Cellular settings")
+	EFastNoise_CellularReturnType cellularReturnType = EFastNoise_CellularReturnType::CellValue;
+
+	/** Maximum warp distance from the original position when using GradientPerturb2D/3D(...). Default: 1.0 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fast Noise|Gradient perturb settings")
+	float gradientPerturbAmp = 1.0f;
+
+	/** Writes the settings to a FastNoise, its cellular noise lookup is left untouched */
+	void ApplyTo(FastNoise& noise) const;
+
+	/** Returns the settings of a FastNoise */
+	static FFastNoiseSettings FromFastNoise(const FastNoise& noise);
+
+	/** Compares every property of the struct, so settings added later are compared too */
+	bool operator==(const FFastNoiseSettings& other) const;
+	bool operator!=(const FFastNoiseSettings& other) const { return !(*this == other); }
+};
+
+/**
+ * Noise built from FFastNoiseSettings without any UObject, e.g. created per async task or on dedicated servers needing a few samples.
+ * The settings are immutable once built, so an evaluator can be sampled from any thread. Copies share the same settings,
+ * copying one into a job only copies a pointer. It samples the same values as a UFastNoiseWrapper set up with the same settings
+ */
+class PROJECT_API FFastNoiseEvaluator
+{
+public:
+
+	/**
+	* Builds the noise of the settings
+	*
+	* @param settings				- the noise settings
+	* @param cellularNoiseLookup	- the noise returned at the closest cell by the NoiseLookup cellular return type, e.g. the snapshot of another evaluator
+	*/
+	explicit FFastNoiseEvaluator(const FFastNoiseSettings& settings = FFastNoiseSettings(), const TSharedPtr<const FastNoise, ESPMode::ThreadSafe>& cellularNoiseLookup = nullptr);
+
+	/** Samples a snapshot of UFastNoiseWrapper::GetSnapshot(), sharing it instead of copying the settings */
+	explicit FFastNoiseEvaluator(const TSharedRef<const FastNoise, ESPMode::ThreadSafe>& snapshot);
+
+	/** Returns the noise calculation given x and y values */
+	float GetNoise2D(const float x, const float y) const { return noiseFunc2D(*noise, x, y); }
+
+	/** Returns the noise calculation given x, y and z values */
+	float GetNoise3D(const float x, const float y, const float z) const { return noiseFunc3D(*noise, x, y, z); }
+
+	/**
+	* Fills a grid of noise values, x varying fastest, with the same values as UFastNoiseWrapper::FillNoise2DGrid(...)
+	*
+	* @param outNoise	- at least sizeX * sizeY values, sample (i, j) being written at index i + j * sizeX
+	* @return false, without writing anything, if outNoise is too small
+	*/
+	bool FillNoise2DGrid(const FVector2D& origin, const FVector2D& step, const int32 sizeX, const int32 sizeY, TArrayView<float> outNoise) const;
+
+	/**
+	* Fills a volume of noise values, x varying fastest and z slowest, with the same values as UFastNoiseWrapper::FillNoise3DGrid(...)
+	*
+	* @param outNoise	- at least sizeX * sizeY * sizeZ values, sample (i, j, k) being written at index i + (j + k * sizeY) * sizeX
+	* @return false, without writing anything, if outNoise is too small
+	*/
+	bool FillNoise3DGrid(const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArrayView<float> outNoise) const;
+
+	/** Returns the noise at scattered positions, see UFastNoiseWrapper::GetNoise2DBatch(...) */
+	bool GetNoise2DBatch(TArrayView<const FVector2D> positions, TArrayView<float> outNoise) const;
+
+	/** Returns the noise at scattered positions, see UFastNoiseWrapper::GetNoise3DBatch(...) */
+	bool GetNoise3DBatch(TArrayView<const FVector> positions, TArrayView<float> outNoise) const;
+
+	/** Same as above with the positions in separate arrays, false if they don't have the same size or outNoise is too small */
+	bool GetNoise2DBatch(TArrayView<const float> x, TArrayView<const float> y, TArrayView<float> outNoise) const;
+	bool GetNoise3DBatch(TArrayView<const float> x, TArrayView<const float> y, TArrayView<const float> z, TArrayView<float> outNoise) const;
+
+	/** Returns the settings, without the cellular noise lookup */
+	FFastNoiseSettings GetSettings() const { return FFastNoiseSettings::FromFastNoise(*noise); }
+
+	/** Returns a hash of every setting affecting the noise, equal hashes give equal noise values */
+	uint64 GetSettingsHash() const { return settingsHash; }
+
+	const FastNoise& GetFastNoise() const { return *noise; }
+
+	/** Returns the settings shared by the copies of the evaluator, e.g. as the cellular noise lookup of another one */
+	const TSharedRef<const FastNoise, ESPMode::ThreadSafe>& GetSnapshot() const { return noise; }
+
+	/** Returns a copy of a FastNoise, keeping the cellular noise lookup it points to alive as long as the copy */
+	static TSharedRef<const FastNoise, ESPMode::ThreadSafe> MakeSnapshot(const FastNoise& noise, const TSharedPtr<const FastNoise, ESPMode::ThreadSafe>& cellularNoiseLookup);
+
+	/** Returns a hash of every setting of a FastNoise affecting GetNoise(...), the cellular noise lookup included */
+	static uint64 HashSettings(const FastNoise& noise);
+
+private:
+
+	TSharedRef<const FastNoise, ESPMode::ThreadSafe> noise;
+
+	/** GetNoise(...) specialized for the noise type, fractal type and interpolation */
+	FastNoise::NoiseFunc2D noiseFunc2D;
+	FastNoise::NoiseFunc3D noiseFunc3D;
+	uint64 settingsHash;
+};
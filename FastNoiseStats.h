@@ -0,0 +1,101 @@
+// FastNoiseStats.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "FastNoise.h"
+
+// Stats of the noise generation, shown by "stat FastNoise". The time is also traced to Unreal Insights by the scopes of the grids,
+// batches and jobs. Counters are updated once per grid, batch or job, as updating them for every sample would cost more than the noise
+DECLARE_STATS_GROUP(TEXT("FastNoise"), STATGROUP_FastNoise, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grids"), STAT_FastNoise_Grid, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scattered batches"), STAT_FastNoise_Batch, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Async jobs"), STAT_FastNoise_AsyncJob, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Streamed chunks"), STAT_FastNoise_Chunk, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cached tiles"), STAT_FastNoise_Tile, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Graphs"), STAT_FastNoise_Graph, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Niagara chunks"), STAT_FastNoise_Niagara, STATGROUP_FastNoise, PROJECT_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Batch calls"), STAT_FastNoise_NumBatches, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Batch samples"), STAT_FastNoise_NumBatchSamples, STATGROUP_FastNoise, PROJECT_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Value samples"), STAT_FastNoise_ValueSamples, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Value fractal samples"), STAT_FastNoise_ValueFractalSamples, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Perlin samples"), STAT_FastNoise_PerlinSamples, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Perlin fractal samples"), STAT_FastNoise_PerlinFractalSamples, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Simplex samples"), STAT_FastNoise_SimplexSamples, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Simplex fractal samples"), STAT_FastNoise_SimplexFractalSamples, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cellular samples"), STAT_FastNoise_CellularSamples, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("White noise samples"), STAT_FastNoise_WhiteNoiseSamples, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cubic samples"), STAT_FastNoise_CubicSamples, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cubic fractal samples"), STAT_FastNoise_CubicFractalSamples, STATGROUP_FastNoise, PROJECT_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tile cache hits"), STAT_FastNoise_TileCacheHits, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tile cache misses"), STAT_FastNoise_TileCacheMisses, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Disk cache hits"), STAT_FastNoise_DiskCacheHits, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Disk cache misses"), STAT_FastNoise_DiskCacheMisses, STATGROUP_FastNoise, PROJECT_API);
+
+// Not reset every frame: the async grids on the task graph or the GPU and the streamed chunks not finished yet
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Async jobs in flight"), STAT_FastNoise_NumAsyncJobs, STATGROUP_FastNoise, PROJECT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Chunks generating"), STAT_FastNoise_NumChunksGenerating, STATGROUP_FastNoise, PROJECT_API);
+
+namespace FastNoiseStats
+{
+	/** Adds the samples of a grid or batch to the counter of its noise type */
+	inline void AddSamples(const FastNoise::NoiseType noiseType, const int64 numSamples)
+	{
+#if STATS
+		switch (noiseType)
+		{
+		case FastNoise::Value:			INC_DWORD_STAT_BY(STAT_FastNoise_ValueSamples, numSamples); break;
+		case FastNoise::ValueFractal:	INC_DWORD_STAT_BY(STAT_FastNoise_ValueFractalSamples, numSamples); break;
+		case FastNoise::Perlin:			INC_DWORD_STAT_BY(STAT_FastNoise_PerlinSamples, numSamples); break;
+		case FastNoise::PerlinFractal:	INC_DWORD_STAT_BY(STAT_FastNoise_PerlinFractalSamples, numSamples); break;
+		case FastNoise::Simplex:		INC_DWORD_STAT_BY(STAT_FastNoise_SimplexSamples, numSamples); break;
+		case FastNoise::SimplexFractal:	INC_DWORD_STAT_BY(STAT_FastNoise_SimplexFractalSamples, numSamples); break;
+		case FastNoise::Cellular:		INC_DWORD_STAT_BY(STAT_FastNoise_CellularSamples, numSamples); break;
+		case FastNoise::WhiteNoise:		INC_DWORD_STAT_BY(STAT_FastNoise_WhiteNoiseSamples, numSamples); break;
+		case FastNoise::Cubic:			INC_DWORD_STAT_BY(STAT_FastNoise_CubicSamples, numSamples); break;
+		case FastNoise::CubicFractal:	INC_DWORD_STAT_BY(STAT_FastNoise_CubicFractalSamples, numSamples); break;
+		}
+#endif
+	}
+
+	/** Counts a scattered batch, its samples included */
+	inline void AddBatch(const FastNoise::NoiseType noiseType, const int64 numSamples)
+	{
+		INC_DWORD_STAT(STAT_FastNoise_NumBatches);
+		INC_DWORD_STAT_BY(STAT_FastNoise_NumBatchSamples, numSamples);
+		AddSamples(noiseType, numSamples);
+	}
+}
@@ -0,0 +1,355 @@
+// FastNoiseTileCache.h
+//
+// MIT License
+//
+// Copyright(c) 2019 Vctor Hernndez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// The developer's email is hm.victor.92@gmail.com
+//
+
+// VERSION: 1.0.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Containers/LruCache.h"
+#include "FastNoiseWrapper.h"
+#include "FastNoiseStats.h"
+#include "FastNoiseTileCache.generated.h"
+
+/**
+ * Cache of precomputed noise tiles, for systems sampling the same positions with the same settings over and over.
+ * Tiles are keyed by the settings hash of the wrapper and the tile coordinate, so one cache can be shared by many wrappers,
+ * and the least recently used tiles are evicted once the memory budget is reached.
+ * Samples are stored on a grid of sampleSpacing, exact lookups outside of that grid skip the cache.
+ * Tiles are generated in one batch from the snapshot of the wrapper, so lookups can run on any thread
+ */
+UCLASS(BlueprintType)
+class PROJECT_API UFastNoiseTileCache : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	* Set the cache properties, clearing every cached tile. Call it before sharing the cache between threads
+	*
+	* @param memoryBudgetMB	- maximum memory used by the cached tiles, in megabytes. Default value: 64
+	* @param sampleSpacing	- distance between two cached samples on each axis. Default value: 1.0
+	* @param tileSize2D		- number of samples on each axis of a 2D tile. Default value: 32
+	* @param tileSize3D		- number of samples on each axis of a 3D tile. Default value: 16
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Tile cache")
+	void SetupTileCache(const int32 memoryBudgetMB = 64, const float sampleSpacing = 1.0f, const int32 tileSize2D = 32, const int32 tileSize3D = 16)
+	{
+		FScopeLock lock(&cacheLock);
+
+		memoryBudget = int64(FMath::Max(memoryBudgetMB, 1)) * 1024 * 1024;
+		spacing = sampleSpacing > 0.0f ? sampleSpacing : 1.0f;
+		tileSize[0] = FMath::Max(tileSize2D, 1);
+		tileSize[1] = FMath::Max(tileSize3D, 1);
+		EmptyTiles();
+	}
+
+	/**
+	* Returns GetNoise2D(x, y) of the wrapper, reading it from the cached tiles
+	*
+	* @param fastNoiseWrapper	- the noise settings
+	* @param x					- the x value
+	* @param y					- the y value
+	* @param bApproximate		- if true, positions between cached samples are bilinearly interpolated instead of calculated
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Tile cache")
+	float GetNoise2D(UFastNoiseWrapper* fastNoiseWrapper, const float x, const float y, const bool bApproximate = false)
+	{
+		if (!fastNoiseWrapper || !fastNoiseWrapper->IsInitialized())
+		{
+			return 0.0f;
+		}
+
+		uint64 settingsHash;
+		const TSharedRef<const FastNoise, ESPMode::ThreadSafe> noise = fastNoiseWrapper->GetSnapshot(settingsHash);
+
+		FIntVector sample;
+		FVector alpha;
+
+		if (!FindSample(FVector(x, y, 0.0f), bApproximate, false, sample, alpha))
+		{
+			misses++;
+			INC_DWORD_STAT(STAT_FastNoise_TileCacheMisses);
+			return noise->GetNoise(x, y);
+		}
+
+		float values[4];
+		ReadSamples(*noise, settingsHash, sample, bApproximate, false, values);
+
+		if (!bApproximate)
+		{
+			return values[0];
+		}
+
+		return FMath::Lerp(FMath::Lerp(values[0], values[1], alpha.X), FMath::Lerp(values[2], values[3], alpha.X), alpha.Y);
+	}
+
+	/**
+	* Returns GetNoise3D(x, y, z) of the wrapper, reading it from the cached tiles
+	*
+	* @param fastNoiseWrapper	- the noise settings
+	* @param x					- the x value
+	* @param y					- the y value
+	* @param z					- the z value
+	* @param bApproximate		- if true, positions between cached samples are trilinearly interpolated instead of calculated
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Tile cache")
+	float GetNoise3D(UFastNoiseWrapper* fastNoiseWrapper, const float x, const float y, const float z, const bool bApproximate = false)
+	{
+		if (!fastNoiseWrapper || !fastNoiseWrapper->IsInitialized())
+		{
+			return 0.0f;
+		}
+
+		uint64 settingsHash;
+		const TSharedRef<const FastNoise, ESPMode::ThreadSafe> noise = fastNoiseWrapper->GetSnapshot(settingsHash);
+
+		FIntVector sample;
+		FVector alpha;
+
+		if (!FindSample(FVector(x, y, z), bApproximate, true, sample, alpha))
+		{
+			misses++;
+			INC_DWORD_STAT(STAT_FastNoise_TileCacheMisses);
+			return noise->GetNoise(x, y, z);
+		}
+
+		float values[8];
+		ReadSamples(*noise, settingsHash, sample, bApproximate, true, values);
+
+		if (!bApproximate)
+		{
+			return values[0];
+		}
+
+		const float bottom = FMath::Lerp(FMath::Lerp(values[0], values[1], alpha.X), FMath::Lerp(values[2], values[3], alpha.X), alpha.Y);
+		const float top = FMath::Lerp(FMath::Lerp(values[4], values[5], alpha.X), FMath::Lerp(values[6], values[7], alpha.X), alpha.Y);
+
+		return FMath::Lerp(bottom, top, alpha.Z);
+	}
+
+	/** Removes every cached tile, the hit and miss counters are kept */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Tile cache")
+	void Empty()
+	{
+		FScopeLock lock(&cacheLock);
+		EmptyTiles();
+	}
+
+	/** Returns the number of lookups read from a cached tile */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Tile cache")
+	int64 GetHits() const { return hits.Load(); }
+
+	/** Returns the number of lookups which had to generate a tile or calculate the noise */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Tile cache")
+	int64 GetMisses() const { return misses.Load(); }
+
+	/** Returns the memory used by the cached tiles, in bytes */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Tile cache")
+	int64 GetMemoryUsed() const { return memoryUsed; }
+
+	/** Sets the hit and miss counters back to 0 */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Tile cache")
+	void ResetCounters() { hits = 0; misses = 0; }
+
+private:
+
+	struct FTileKey
+	{
+		uint64 settingsHash;
+		FIntVector coord;
+		bool b3D;
+
+		bool operator==(const FTileKey& other) const { return settingsHash == other.settingsHash && coord == other.coord && b3D == other.b3D; }
+
+		friend uint32 GetTypeHash(const FTileKey& key) { return HashCombine(HashCombine(GetTypeHash(key.settingsHash), GetTypeHash(key.coord)), uint32(key.b3D)); }
+	};
+
+	/**
+	* Finds the cached sample for a position, with the interpolation weights to the next samples if approximate.
+	* Exact lookups only succeed on positions lying on the sample grid
+	*/
+	bool FindSample(const FVector& position, const bool bApproximate, const bool b3D, FIntVector& outSample, FVector& outAlpha) const
+	{
+		const int32 numAxes = b3D ? 3 : 2;
+		outSample = FIntVector::ZeroValue;
+		outAlpha = FVector::ZeroVector;
+
+		for (int32 axis = 0; axis < numAxes; axis++)
+		{
+			const float gridPosition = position[axis] / spacing;
+
+			if (FMath::Abs(gridPosition) >= float(MAX_int32 / 2))
+			{
+				return false;
+			}
+
+			if (bApproximate)
+			{
+				outSample[axis] = FMath::FloorToInt(gridPosition);
+				outAlpha[axis] = gridPosition - outSample[axis];
+			}
+			else
+			{
+				outSample[axis] = FMath::RoundToInt(gridPosition);
+
+				// The tiles are generated at sample * spacing, so this position is cached only if it is computed the same way
+				if (float(outSample[axis]) * spacing != position[axis])
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	* Reads the sample, or the 4 (2D) or 8 (3D) corners of its cell if approximate, generating the tile on a miss.
+	* Tiles overlap by one sample so the corners of a cell are always in the same tile
+	*/
+	void ReadSamples(const FastNoise& noise, const uint64 settingsHash, const FIntVector& sample, const bool bApproximate, const bool b3D, float* outValues)
+	{
+		const int32 size = tileSize[b3D];
+		const int32 stride = size + 1;
+
+		FTileKey key;
+		key.settingsHash = settingsHash;
+		key.coord = FIntVector(FloorDiv(sample.X, size), FloorDiv(sample.Y, size), b3D ? FloorDiv(sample.Z, size) : 0);
+		key.b3D = b3D;
+
+		const FIntVector local = sample - key.coord * size;
+		const int32 index = local.X + local.Y * stride + (b3D ? local.Z * stride * stride : 0);
+		const int32 numCorners = !bApproximate ? 1 : b3D ? 8 : 4;
+
+		// The lookups already take the lock, so the stats are updated with it rather than aggregated
+		{
+			FScopeLock lock(&cacheLock);
+
+			if (const TArray<float>* tile = tiles.FindAndTouch(key))
+			{
+				hits++;
+				INC_DWORD_STAT(STAT_FastNoise_TileCacheHits);
+				ReadCorners(*tile, index, stride, numCorners, outValues);
+				return;
+			}
+
+			misses++;
+			INC_DWORD_STAT(STAT_FastNoise_TileCacheMisses);
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_FastNoise_Tile);
+		TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_GenerateTile);
+
+		// Generated outside of the lock so other threads can keep reading their tiles, at the positions FindSample(...) checks exact lookups against
+		const int32 numSamples = b3D ? stride * stride * stride : stride * stride;
+		TArray<float> tile, x, y, z;
+		tile.SetNumUninitialized(numSamples);
+		x.SetNumUninitialized(numSamples);
+		y.SetNumUninitialized(numSamples);
+		z.SetNumUninitialized(b3D ? numSamples : 0);
+
+		for (int32 i = 0; i < numSamples; i++)
+		{
+			x[i] = float(key.coord.X * size + i % stride) * spacing;
+			y[i] = float(key.coord.Y * size + (i / stride) % stride) * spacing;
+
+			if (b3D)
+			{
+				z[i] = float(key.coord.Z * size + i / (stride * stride)) * spacing;
+			}
+		}
+
+		FastNoiseStats::AddBatch(noise.GetNoiseType(), numSamples);
+
+		if (b3D)
+		{
+			noise.FillNoiseSetPoints3D(tile.GetData(), x.GetData(), y.GetData(), z.GetData(), numSamples);
+		}
+		else
+		{
+			noise.FillNoiseSetPoints2D(tile.GetData(), x.GetData(), y.GetData(), numSamples);
+		}
+
+		ReadCorners(tile, index, stride, numCorners, outValues);
+
+		FScopeLock lock(&cacheLock);
+
+		// Another thread may have generated the same tile meanwhile
+		if (tiles.Contains(key))
+		{
+			return;
+		}
+
+		const int64 tileBytes = tile.Num() * sizeof(float);
+
+		while (tiles.Num() > 0 && memoryUsed + tileBytes > memoryBudget)
+		{
+			memoryUsed -= tiles.RemoveLeastRecent().Num() * sizeof(float);
+		}
+
+		if (tileBytes <= memoryBudget)
+		{
+			tiles.Add(key, tile);
+			memoryUsed += tileBytes;
+		}
+	}
+
+	static void ReadCorners(const TArray<float>& tile, const int32 index, const int32 stride, const int32 numCorners, float* outValues)
+	{
+		for (int32 corner = 0; corner < numCorners; corner++)
+		{
+			outValues[corner] = tile[index + (corner & 1) + ((corner >> 1) & 1) * stride + (corner >> 2) * stride * stride];
+		}
+	}
+
+	static int32 FloorDiv(const int32 value, const int32 divisor)
+	{
+		return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+	}
+
+	void EmptyTiles()
+	{
+		// The smallest tile sets the capacity so the LRU never evicts on its own, eviction is done by memory used
+		const int64 smallestTileBytes = FMath::Min(FMath::Square(tileSize[0] + 1), FMath::Square(tileSize[1] + 1) * (tileSize[1] + 1)) * sizeof(float);
+		tiles.Empty(int32(FMath::Min<int64>(memoryBudget / smallestTileBytes + 1, MAX_int32)));
+		memoryUsed = 0;
+	}
+
+	TLruCache<FTileKey, TArray<float>> tiles { int32(64 * 1024 * 1024 / (33 * 33 * sizeof(float)) + 1) };
+	FCriticalSection cacheLock;
+
+	int64 memoryBudget = 64 * 1024 * 1024;
+	int64 memoryUsed = 0;
+	float spacing = 1.0f;
+	int32 tileSize[2] = { 32, 16 };
+
+	TAtomic<int64> hits { 0 };
+	TAtomic<int64> misses { 0 };
+};
@@ -28,5 +28,59 @@
 // VERSION: 1.0.0
 
 #include "FastNoiseWrapper.h"
+#include "FastNoiseTileCache.h"
 
-// Nothing to do here
+DEFINE_STAT(STAT_FastNoise_Grid);
+DEFINE_STAT(STAT_FastNoise_Batch);
+DEFINE_STAT(STAT_FastNoise_AsyncJob);
+DEFINE_STAT(STAT_FastNoise_Chunk);
+DEFINE_STAT(STAT_FastNoise_Tile);
+DEFINE_STAT(STAT_FastNoise_Graph);
+DEFINE_STAT(STAT_FastNoise_Niagara);
+DEFINE_STAT(STAT_FastNoise_NumBatches);
+DEFINE_STAT(STAT_FastNoise_NumBatchSamples);
+DEFINE_STAT(STAT_FastNoise_ValueSamples);
+DEFINE_STAT(STAT_FastNoise_ValueFractalSamples);
+DEFINE_STAT(STAT_FastNoise_PerlinSamples);
+DEFINE_STAT(STAT_FastNoise_PerlinFractalSamples);
+DEFINE_STAT(STAT_FastNoise_SimplexSamples);
+DEFINE_STAT(STAT_FastNoise_SimplexFractalSamples);
+DEFINE_STAT(STAT_FastNoise_CellularSamples);
+DEFINE_STAT(STAT_FastNoise_WhiteNoiseSamples);
+DEFINE_STAT(STAT_FastNoise_CubicSamples);
+DEFINE_STAT(STAT_FastNoise_CubicFractalSamples);
+DEFINE_STAT(STAT_FastNoise_TileCacheHits);
+DEFINE_STAT(STAT_FastNoise_TileCacheMisses);
+DEFINE_STAT(STAT_FastNoise_DiskCacheHits);
+DEFINE_STAT(STAT_FastNoise_DiskCacheMisses);
+DEFINE_STAT(STAT_FastNoise_NumAsyncJobs);
+DEFINE_STAT(STAT_FastNoise_NumChunksGenerating);
+
+float UFastNoiseWrapper::GetCachedNoise2D(const float x, const float y)
+{
+	return tileCache->GetNoise2D(this, x, y, bTileCacheApproximate);
+}
+
+float UFastNoiseWrapper::GetCachedNoise3D(const float x, const float y, const float z)
+{
+	return tileCache->GetNoise3D(this, x, y, z, bTileCacheApproximate);
+}
+
+void UFastNoiseWrapper::PostLoad()
+{
+	Super::PostLoad();
+
+	// Only the settings are saved, the noise and its snapshot are rebuilt from them
+	noiseSettings.ApplyTo(fastNoise);
+	PublishSnapshot();
+}
+
+#if WITH_EDITOR
+void UFastNoiseWrapper::PostEditChangeProperty(FPropertyChangedEvent& propertyChangedEvent)
+{
+	Super::PostEditChangeProperty(propertyChangedEvent);
+
+	// Editing the settings initializes the wrapper, like SetupFastNoise(...)
+	SetSettings(FFastNoiseSettings(noiseSettings));
+}
+#endif
@@ -31,26 +31,49 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "TextureResource.h"
+#include "RenderingThread.h"
 #include "FastNoise.h"
+#include "FastNoiseSettings.h"
+#include "FastNoiseCompute.h"
+#include "FastNoiseStats.h"
 #include "FastNoiseWrapper.generated.h"
 
-// Fast Noise UE4 enum wrappers
-UENUM(BlueprintType) enum class EFastNoise_NoiseType				: uint8 { Value, ValueFractal, Perlin, PerlinFractal, Simplex, SimplexFractal, Cellular, WhiteNoise, Cubic, CubicFractal };
-UENUM(BlueprintType) enum class EFastNoise_Interp					: uint8 { Linear, Hermite, Quintic };
-UENUM(BlueprintType) enum class EFastNoise_FractalType				: uint8 { FBM, Billow, RigidMulti };
-UENUM(BlueprintType) enum class EFastNoise_CellularDistanceFunction	: uint8 { Euclidean, Manhattan, Natural };
-UENUM(BlueprintType) enum class EFastNoise_CellularReturnType		: uint8 { CellValue, /*NoiseLookup,*/ Distance, Distance2, Distance2Add, Distance2Sub, Distance2Mul, Distance2Div };
+// Texel formats of the noise textures
+UENUM(BlueprintType) enum class EFastNoise_TextureFormat			: uint8 { R8, R16F, R32F };
+
+// Settings reported by OnSettingsChanged, as bits 1 << setting of a mask
+UENUM(BlueprintType, meta = (Bitflags)) enum class EFastNoise_Setting	: uint8 { NoiseType, Seed, Frequency, Interpolation, IndexMode, FractalType, Octaves, Lacunarity, Gain, FractalAmplitudeThreshold, CellularJitter, DistanceFunction, ReturnType, CellularNoiseLookup, GradientPerturbAmp };
+
+class UFastNoiseWrapper;
+class UFastNoiseTileCache;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFastNoiseSettingsChanged, UFastNoiseWrapper*, fastNoiseWrapper, int32, changedSettings);
 
 /**
- * UE4 Wrapper for Auburns's FastNoise library, also available for blueprints usage
+ * UE4 Wrapper for Auburns's FastNoise library, also available for blueprints usage.
+ * The noise itself doesn't need the wrapper, FFastNoiseEvaluator samples FFastNoiseSettings without any UObject.
+ * The settings are saved with the wrapper, so wrappers can be edited inline in data assets
  */
-UCLASS(BlueprintType)
+UCLASS(BlueprintType, EditInlineNew)
 class PROJECT_API UFastNoiseWrapper : public UObject
 {
 	GENERATED_BODY()
 
 public:
 
+	/**
+	* Called when the settings change, with the mask of the settings whose value changed, e.g. for tools regenerating their previews.
+	* Setting a value equal to the current one doesn't call it, and SetupFastNoise(...) calls it once for all the settings it changed
+	*/
+	UPROPERTY(BlueprintAssignable)
+	FFastNoiseSettingsChanged OnSettingsChanged;
+
 	/**
 	* Set all the properties needed to generate the noise
 	*
@@ -65,6 +88,7 @@ public:
 	* @param cellularJitter				- maximum distance a cellular point can move from its grid position. Setting this high will make artifacts more common. Default value: 0.45
 	* @param cellularDistanceFunction	- distance function used in cellular noise calculations. The distance function used to calculate the cell for a given point. Natural is a blend of Euclidean and Manhattan to give curved cell boundaries. Default value: Euclidean
 	* @param cellularReturnType			- return type from cellular noise calculations. Default value: CellValue
+	* @param gradientPerturbAmp			- maximum warp distance from the original position when using GradientPerturb2D/3D(...). Default value: 1.0
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
 	void SetupFastNoise
@@ -79,359 +103,1533 @@ public:
 		const float gain = 0.5f,
 		const float cellularJitter = 0.45f,
 		const EFastNoise_CellularDistanceFunction cellularDistanceFunction = EFastNoise_CellularDistanceFunction::Euclidean,
-		const EFastNoise_CellularReturnType cellularReturnType = EFastNoise_CellularReturnType::CellValue
+		const EFastNoise_CellularReturnType cellularReturnType = EFastNoise_CellularReturnType::CellValue,
+		const float gradientPerturbAmp = 1.0f
 	)
 	{
-		SetNoiseType(noiseType);
-		SetSeed(seed);
-		SetFrequency(frequency);
-		SetInterpolation(interp);
-		SetFractalType(fractaltype);
-		SetOctaves(octaves);
-		SetLacunarity(lacunarity);
-		SetGain(gain);
-		SetCellularJitter(cellularJitter);
-		SetDistanceFunction(cellularDistanceFunction);
-		SetReturnType(cellularReturnType);
+		// The index mode and the amplitude threshold keep their current values
+		FFastNoiseSettings settings = GetSettings();
+		settings.noiseType = noiseType;
+		settings.seed = seed;
+		settings.frequency = frequency;
+		settings.interp = interp;
+		settings.fractalType = fractaltype;
+		settings.octaves = octaves;
+		settings.lacunarity = lacunarity;
+		settings.gain = gain;
+		settings.cellularJitter = cellularJitter;
+		settings.cellularDistanceFunction = cellularDistanceFunction;
+		settings.cellularReturnType = cellularReturnType;
+		settings.gradientPerturbAmp = gradientPerturbAmp;
+
+		SetSettings(settings);
+	}
 
+	/**
+	* Set all the settings at once, e.g. from a data asset, and initializes the noise like SetupFastNoise(...).
+	* The cellular noise lookup is kept, OnSettingsChanged is called once for all the settings changed
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	void SetSettings(const FFastNoiseSettings& settings)
+	{
+		settings.ApplyTo(fastNoise);
 		bInitialized = true;
+
+		PublishSnapshot();
+	}
+
+	/** Returns the current settings, without the cellular noise lookup */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise")
+	FFastNoiseSettings GetSettings() const { return noiseSettings; }
+
+	/** Returns the evaluator sampling the current snapshot, to be copied into tasks without keeping the wrapper alive */
+	const FFastNoiseEvaluator& GetEvaluator() const { return evaluator; }
+
+	// UObject interface
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& propertyChangedEvent) override;
+#endif
+
+	/**
+	* Returns an immutable copy of the current settings, safe to sample from any thread.
+	* Changing the settings publishes a new snapshot and leaves the previous ones untouched,
+	* so generation tasks holding a snapshot keep reading consistent settings until they finish
+	*/
+	TSharedRef<const FastNoise, ESPMode::ThreadSafe> GetSnapshot()
+	{
+		FScopeLock lock(&snapshotLock);
+
+		if (!snapshot.IsValid())
+		{
+			snapshot = CopySettings();
+			snapshotHash = FFastNoiseEvaluator::HashSettings(*snapshot);
+		}
+
+		return snapshot.ToSharedRef();
+	}
+
+	/** Returns the current snapshot and its settings hash, read together so they always match, e.g. to key cached values from any thread */
+	TSharedRef<const FastNoise, ESPMode::ThreadSafe> GetSnapshot(uint64& outSettingsHash)
+	{
+		FScopeLock lock(&snapshotLock);
+
+		if (!snapshot.IsValid())
+		{
+			snapshot = CopySettings();
+			snapshotHash = FFastNoiseEvaluator::HashSettings(*snapshot);
+		}
+
+		outSettingsHash = snapshotHash;
+		return snapshot.ToSharedRef();
+	}
+
+	/** Returns a hash of every setting affecting GetNoise2D/3D(...), equal hashes give equal noise values */
+	uint64 GetSettingsHash() const { return settingsHash; }
+
+	/** Returns a number increased every time the settings change, to be given back to GetSettingsChangedSince(...) */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Change tracking")
+	int32 GetSettingsVersion() const { return settingsVersion; }
+
+	/** Returns the mask of the settings changed after GetSettingsVersion() returned version, for tools polling instead of binding OnSettingsChanged */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Change tracking", meta = (Bitmask, BitmaskEnum = "EFastNoise_Setting"))
+	int32 GetSettingsChangedSince(const int32 version) const
+	{
+		int32 changedSettings = 0;
+
+		for (int32 setting = 0; setting < NumSettings; setting++)
+		{
+			if (settingVersions[setting] > version)
+			{
+				changedSettings |= 1 << setting;
+			}
+		}
+
+		return changedSettings;
 	}
 
+	/** Returns whether a setting is part of a mask of OnSettingsChanged or GetSettingsChangedSince(...) */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Change tracking")
+	static bool IsSettingChanged(const int32 changedSettings, const EFastNoise_Setting setting) { return (changedSettings & (1 << int32(setting))) != 0; }
+
+	/** Returns whether a mask of changed settings changes the noise values, only GradientPerturbAmp leaves them unchanged as it only applies to warps */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Change tracking")
+	static bool IsNoiseChanged(const int32 changedSettings) { return (changedSettings & ~(1 << int32(EFastNoise_Setting::GradientPerturbAmp))) != 0; }
+
 	/** Returns if Fast Noise properties are initialized or not */
 	UFUNCTION(BlueprintPure, Category = "Fast Noise")
 	bool IsInitialized() { return bInitialized; }
 
 	/**
-	* Returns the noise calculation given x and y values
+	* Returns the noise calculation given x and y values, read from the tile cache if one is set
 	*
 	* @param x	- the x value
 	* @param y	- the y value
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
-	float GetNoise2D(const float x, const float y) { return IsInitialized() ? fastNoise.GetNoise(x, y) : 0.0f; }
+	float GetNoise2D(const float x, const float y)
+	{
+		if (!IsInitialized())
+		{
+			return 0.0f;
+		}
+
+		return tileCache ? GetCachedNoise2D(x, y) : noiseFunc2D(fastNoise, x, y);
+	}
 
 	/**
-	* Returns the noise calculation given x, y and z values
+	* Returns the noise calculation given x, y and z values, read from the tile cache if one is set
 	*
 	* @param x	- the x value
 	* @param y	- the y value
 	* @param z	- the z value
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
-	float GetNoise3D(const float x, const float y, const float z = 0.0f) { return IsInitialized() ? fastNoise.GetNoise(x, y, z) : 0.0f; }
-
-
-	//***********************************************************
-	//*********************     GETTERS     *********************
-	//***********************************************************
-
-	/** Gets noise type */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|General settings")
-	EFastNoise_NoiseType GetNoiseType()
+	float GetNoise3D(const float x, const float y, const float z = 0.0f)
 	{
-		switch (fastNoise.GetNoiseType())
+		if (!IsInitialized())
 		{
-		case FastNoise::NoiseType::Value:
-			return EFastNoise_NoiseType::Value;
-
-		case FastNoise::NoiseType::ValueFractal:
-			return EFastNoise_NoiseType::ValueFractal;
-
-		case FastNoise::NoiseType::Perlin:
-			return EFastNoise_NoiseType::Perlin;
+			return 0.0f;
+		}
 
-		case FastNoise::NoiseType::PerlinFractal:
-			return EFastNoise_NoiseType::PerlinFractal;
+		return tileCache ? GetCachedNoise3D(x, y, z) : noiseFunc3D(fastNoise, x, y, z);
+	}
 
-		case FastNoise::NoiseType::SimplexFractal:
-			return EFastNoise_NoiseType::SimplexFractal;
+	/**
+	* Set the tile cache GetNoise2D/3D(...) read from, for systems sampling the same positions over and over.
+	* The grids, batches and snapshots always calculate the noise
+	*
+	* @param cache			- the tile cache, it can be shared by many wrappers. nullptr calculates every value again
+	* @param bApproximate	- if true, positions between cached samples are interpolated instead of calculated. Default value: false
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Tile cache")
+	void SetTileCache(UFastNoiseTileCache* cache, const bool bApproximate = false)
+	{
+		tileCache = cache;
+		bTileCacheApproximate = bApproximate;
+	}
 
-		case FastNoise::NoiseType::Cellular:
-			return EFastNoise_NoiseType::Cellular;
+	/** Returns the tile cache set with SetTileCache(...), nullptr if none */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Tile cache")
+	UFastNoiseTileCache* GetTileCache() const { return tileCache; }
 
-		case FastNoise::NoiseType::WhiteNoise:
-			return EFastNoise_NoiseType::WhiteNoise;
+	/**
+	* Returns the 4D noise calculation given x, y, z and w values. Only Simplex and SimplexFractal have a 4D version, the other noise types return 0
+	*
+	* @param x	- the x value
+	* @param y	- the y value
+	* @param z	- the z value
+	* @param w	- the w value
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	float GetNoise4D(const float x, const float y, const float z, const float w)
+	{
+		if (!IsInitialized())
+		{
+			return 0.0f;
+		}
 
-		case FastNoise::NoiseType::Cubic:
-			return EFastNoise_NoiseType::Cubic;
+		switch (fastNoise.GetNoiseType())
+		{
+		case FastNoise::NoiseType::Simplex:
+			return fastNoise.GetSimplex(x, y, z, w);
 
-		case FastNoise::NoiseType::CubicFractal:
-			return EFastNoise_NoiseType::CubicFractal;
+		case FastNoise::NoiseType::SimplexFractal:
+			return fastNoise.GetSimplexFractal(x, y, z, w);
 
-		case FastNoise::NoiseType::Simplex:
 		default:
-			return EFastNoise_NoiseType::Simplex;
+			return 0.0f;
 		}
 	}
 
-	/** Gets seed. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|General settings")
-	int32 GetSeed() { return fastNoise.GetSeed(); }
-
-	/** Gets frequency. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|General settings")
-	float GetFrequency() { return fastNoise.GetFrequency(); }
+	/**
+	* Returns the same values as GetNoise2D(...) at scattered positions, e.g. foliage instances or AI queries.
+	* Value, Perlin, Simplex and their fractals evaluate 4 positions at once with SSE2, the other noise types one at a time
+	*
+	* @param positions	- the x and y values to sample
+	* @param outNoise	- at least positions.Num() values, the noise at positions[i] being written at index i
+	* @return false, without writing anything, if outNoise is too small
+	*/
+	bool GetNoise2DBatch(TArrayView<const FVector2D> positions, TArrayView<float> outNoise)
+	{
+		return IsInitialized() ? evaluator.GetNoise2DBatch(positions, outNoise) : ZeroNoise(positions.Num(), outNoise);
+	}
 
-	/** Gets interpolation type. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|General settings")
-	EFastNoise_Interp GetInterpolation()
+	/**
+	* Same as above with the positions in separate x and y arrays, e.g. the position streams of particles
+	*
+	* @return false, without writing anything, if the arrays don't have the same size or outNoise is too small
+	*/
+	bool GetNoise2DBatch(TArrayView<const float> x, TArrayView<const float> y, TArrayView<float> outNoise)
 	{
-		switch (fastNoise.GetInterp())
+		if (!IsInitialized())
 		{
-		case FastNoise::Interp::Linear:
-			return EFastNoise_Interp::Linear;
+			return y.Num() == x.Num() && ZeroNoise(x.Num(), outNoise);
+		}
 
-		case FastNoise::Interp::Hermite:
-			return EFastNoise_Interp::Hermite;
+		return evaluator.GetNoise2DBatch(x, y, outNoise);
+	}
 
-		case FastNoise::Interp::Quintic:
-		default:
-			return EFastNoise_Interp::Quintic;
-		}
+	/**
+	* Returns the same values as GetNoise3D(...) at scattered positions, e.g. foliage instances or AI queries.
+	* Value, Perlin, Simplex and their fractals evaluate 4 positions at once with SSE2, the other noise types one at a time
+	*
+	* @param positions	- the x, y and z values to sample
+	* @param outNoise	- at least positions.Num() values, the noise at positions[i] being written at index i
+	* @return false, without writing anything, if outNoise is too small
+	*/
+	bool GetNoise3DBatch(TArrayView<const FVector> positions, TArrayView<float> outNoise)
+	{
+		return IsInitialized() ? evaluator.GetNoise3DBatch(positions, outNoise) : ZeroNoise(positions.Num(), outNoise);
 	}
 
-	/** Gets fractal type. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
-	EFastNoise_FractalType GetFractalType()
+	/**
+	* Same as above with the positions in separate x, y and z arrays, e.g. the position streams of particles
+	*
+	* @return false, without writing anything, if the arrays don't have the same size or outNoise is too small
+	*/
+	bool GetNoise3DBatch(TArrayView<const float> x, TArrayView<const float> y, TArrayView<const float> z, TArrayView<float> outNoise)
 	{
-		switch (fastNoise.GetFractalType())
+		if (!IsInitialized())
 		{
-		case FastNoise::FractalType::Billow:
-			return EFastNoise_FractalType::Billow;
+			return y.Num() == x.Num() && z.Num() == x.Num() && ZeroNoise(x.Num(), outNoise);
+		}
 
-		case FastNoise::FractalType::RigidMulti:
-			return EFastNoise_FractalType::RigidMulti;
+		return evaluator.GetNoise3DBatch(x, y, z, outNoise);
+	}
 
-		case FastNoise::FractalType::FBM:
-		default:
-			return EFastNoise_FractalType::FBM;
-		}
+	/**
+	* Returns the noise at every position, same as calling GetNoise3D(...) for each of them but much faster from blueprints
+	*
+	* @param positions	- the x, y and z values to sample
+	* @param outNoise	- the noise values, the noise at positions[i] being at index i
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	void GetNoise3DAtPositions(const TArray<FVector>& positions, TArray<float>& outNoise)
+	{
+		outNoise.SetNumUninitialized(positions.Num());
+		GetNoise3DBatch(positions, outNoise);
 	}
 
-	/** Gets fractal octaves. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
-	int32 GetOctaves() { return fastNoise.GetFractalOctaves(); }
+	/**
+	* Returns the noise calculation given x and y values, along with its derivative.
+	* The derivative is exact for Perlin and Simplex noise and their fractals, and estimated with central differences for the other noise types
+	*
+	* @param x			- the x value
+	* @param y			- the y value
+	* @param derivative	- the partial derivatives of the noise along x and y
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	float GetNoiseWithDerivative2D(const float x, const float y, FVector2D& derivative)
+	{
+		FN_DECIMAL dx = 0, dy = 0;
+		const float noise = IsInitialized() ? fastNoise.GetNoiseWithDerivative(x, y, dx, dy) : 0.0f;
 
-	/** Gets fractal lacunarity. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
-	float GetLacunarity() { return fastNoise.GetFractalLacunarity(); }
+		derivative = FVector2D(dx, dy);
+		return noise;
+	}
 
-	/** Gets fractal gain. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
-	float GetGain() { return fastNoise.GetFractalGain(); }
+	/**
+	* Returns the noise calculation given x, y and z values, along with its derivative.
+	* The derivative is exact for Perlin and Simplex noise and their fractals, and estimated with central differences for the other noise types.
+	* Normalizing the derivative gives the normal of the noise isosurfaces, useful for terrain normals without sampling neighbours
+	*
+	* @param x			- the x value
+	* @param y			- the y value
+	* @param z			- the z value
+	* @param derivative	- the partial derivatives of the noise along x, y and z
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	float GetNoiseWithDerivative3D(const float x, const float y, const float z, FVector& derivative)
+	{
+		FN_DECIMAL dx = 0, dy = 0, dz = 0;
+		const float noise = IsInitialized() ? fastNoise.GetNoiseWithDerivative(x, y, z, dx, dy, dz) : 0.0f;
 
-	/** Gets cellular jitter. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|Cellular settings")
-	float GetCellularJitter() { return fastNoise.GetCellularJitter(); }
+		derivative = FVector(dx, dy, dz);
+		return noise;
+	}
 
-	/** Gets cellular distance function. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|Cellular settings")
-	EFastNoise_CellularDistanceFunction GetDistanceFunction()
+	/**
+	* Returns conservative bounds of GetNoise2D(...) over a rectangle, every value of the rectangle lying in [outMin, outMax].
+	* The lowest octaves are sampled on samplesPerAxis^2 points, so areas entirely above or below a threshold can be skipped without generating them
+	*
+	* @param boxMin			- the lowest x and y values of the rectangle
+	* @param boxMax			- the highest x and y values of the rectangle
+	* @param samplesPerAxis	- the number of samples along each axis, more samples give tighter bounds for rectangles larger than the features
+	* @return whether the bounds are known, cellular return types other than CellValue are unbounded
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	bool GetNoise2DBounds(const FVector2D boxMin, const FVector2D boxMax, float& outMin, float& outMax, const int32 samplesPerAxis = 5)
 	{
-		switch (fastNoise.GetCellularDistanceFunction())
-		{
-		case FastNoise::CellularDistanceFunction::Manhattan:
-			return EFastNoise_CellularDistanceFunction::Manhattan;
-
-		case FastNoise::CellularDistanceFunction::Natural:
-			return EFastNoise_CellularDistanceFunction::Natural;
+		FN_DECIMAL min = 0, max = 0;
+		const bool bBounded = IsInitialized() && fastNoise.GetNoiseBounds2D(boxMin.X, boxMin.Y, boxMax.X, boxMax.Y, min, max, samplesPerAxis);
 
-		case FastNoise::CellularDistanceFunction::Euclidean:
-		default:
-			return EFastNoise_CellularDistanceFunction::Euclidean;
-		}
+		outMin = min;
+		outMax = max;
+		return bBounded;
 	}
 
-	/** Gets cellular return type. */
-	UFUNCTION(BlueprintPure, Category = "Fast Noise|Cellular settings")
-	EFastNoise_CellularReturnType GetReturnType()
+	/**
+	* Returns conservative bounds of GetNoise3D(...) over a box, e.g. to skip the voxel chunks entirely solid or entirely empty, see GetNoise2DBounds(...)
+	*
+	* @param boxMin			- the lowest x, y and z values of the box
+	* @param boxMax			- the highest x, y and z values of the box
+	* @param samplesPerAxis	- the number of samples along each axis, the lowest octaves being sampled on samplesPerAxis^3 points
+	* @return whether the bounds are known, cellular return types other than CellValue are unbounded
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	bool GetNoise3DBounds(const FVector boxMin, const FVector boxMax, float& outMin, float& outMax, const int32 samplesPerAxis = 5)
 	{
-		switch (fastNoise.GetCellularReturnType())
-		{
-		/*case FastNoise::CellularReturnType::NoiseLookup:
-			return EFastNoise_CellularReturnType::NoiseLookup;*/
+		FN_DECIMAL min = 0, max = 0;
+		const bool bBounded = IsInitialized() && fastNoise.GetNoiseBounds3D(boxMin.X, boxMin.Y, boxMin.Z, boxMax.X, boxMax.Y, boxMax.Z, min, max, samplesPerAxis);
 
-		case FastNoise::CellularReturnType::Distance:
-			return EFastNoise_CellularReturnType::Distance;
+		outMin = min;
+		outMax = max;
+		return bBounded;
+	}
 
-		case FastNoise::CellularReturnType::Distance2:
-			return EFastNoise_CellularReturnType::Distance2;
+	/**
+	* Fills a grid of noise values given an origin, a step and the grid dimensions, x varying fastest.
+	* Much faster than calling GetNoise2D for every sample, specially from blueprints
+	*
+	* @param origin		- the x and y values of the first sample
+	* @param step		- the distance between two consecutive samples on each axis
+	* @param sizeX		- the number of samples along x
+	* @param sizeY		- the number of samples along y
+	* @param outNoise	- the sizeX * sizeY noise values, sample (i, j) being at index i + j * sizeX
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	void GetNoise2DGrid(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, TArray<float>& outNoise)
+	{
+		outNoise.SetNumUninitialized(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0));
+		FillNoise2DGrid(origin, step, sizeX, sizeY, outNoise);
+	}
 
-		case FastNoise::CellularReturnType::Distance2Add:
-			return EFastNoise_CellularReturnType::Distance2Add;
+	/**
+	* Same as GetNoise2DGrid(...), writing into memory owned by the caller instead of allocating, e.g. a FFastNoiseBuffer
+	*
+	* @param outNoise	- at least sizeX * sizeY values, sample (i, j) being written at index i + j * sizeX
+	* @return false, without writing anything, if outNoise is too small
+	*/
+	bool FillNoise2DGrid(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, TArrayView<float> outNoise)
+	{
+		return IsInitialized() ? evaluator.FillNoise2DGrid(origin, step, sizeX, sizeY, outNoise) : ZeroNoise(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0), outNoise);
+	}
 
-		case FastNoise::CellularReturnType::Distance2Sub:
-			return EFastNoise_CellularReturnType::Distance2Sub;
+	/**
+	* Fills a volume of noise values given an origin, a step and the volume dimensions, x varying fastest and z slowest.
+	* Much faster than calling GetNoise3D for every sample, specially from blueprints
+	*
+	* @param origin		- the x, y and z values of the first sample
+	* @param step		- the distance between two consecutive samples on each axis
+	* @param sizeX		- the number of samples along x
+	* @param sizeY		- the number of samples along y
+	* @param sizeZ		- the number of samples along z
+	* @param outNoise	- the sizeX * sizeY * sizeZ noise values, sample (i, j, k) being at index i + (j + k * sizeY) * sizeX
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	void GetNoise3DGrid(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArray<float>& outNoise)
+	{
+		outNoise.SetNumUninitialized(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0));
+		FillNoise3DGrid(origin, step, sizeX, sizeY, sizeZ, outNoise);
+	}
 
-		case FastNoise::CellularReturnType::Distance2Mul:
-			return EFastNoise_CellularReturnType::Distance2Mul;
+	/**
+	* Same as GetNoise3DGrid(...), writing into memory owned by the caller instead of allocating, e.g. a FFastNoiseBuffer
+	*
+	* @param outNoise	- at least sizeX * sizeY * sizeZ values, sample (i, j, k) being written at index i + (j + k * sizeY) * sizeX
+	* @return false, without writing anything, if outNoise is too small
+	*/
+	bool FillNoise3DGrid(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArrayView<float> outNoise)
+	{
+		return IsInitialized() ? evaluator.FillNoise3DGrid(origin, step, sizeX, sizeY, sizeZ, outNoise) : ZeroNoise(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0), outNoise);
+	}
 
-		case FastNoise::CellularReturnType::Distance2Div:
-			return EFastNoise_CellularReturnType::Distance2Div;
+	/**
+	* Regenerates a region of a grid filled by FillNoise2DGrid(...), e.g. the part of a preview visible in the viewport after a settings change.
+	* The samples of the region get the same values as a full FillNoise2DGrid(...) call, the other samples are left untouched
+	*
+	* @param origin		- the x and y values of the first sample of the whole grid
+	* @param step		- the distance between two consecutive samples on each axis
+	* @param sizeX		- the number of samples of the whole grid along x
+	* @param sizeY		- the number of samples of the whole grid along y
+	* @param region		- the samples to regenerate, from Min included to Max excluded, clipped to the grid
+	* @param outNoise	- the whole grid, at least sizeX * sizeY values, sample (i, j) being at index i + j * sizeX
+	* @return false, without writing anything, if outNoise is too small
+	*/
+	bool FillNoise2DGridRegion(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, const FIntRect& region, TArrayView<float> outNoise)
+	{
+		return FillNoiseGridRegion(FVector(origin.X, origin.Y, 0.0f), FVector(step.X, step.Y, 0.0f), sizeX, sizeY, 1, FIntVector(region.Min.X, region.Min.Y, 0), FIntVector(region.Max.X, region.Max.Y, 1), false, outNoise);
+	}
 
-		case FastNoise::CellularReturnType::CellValue:
-		default:
-			return EFastNoise_CellularReturnType::CellValue;
-		}
+	/**
+	* Same as FillNoise2DGridRegion(...) for blueprints, regenerating the samples from regionMin included to regionMax excluded of a grid of GetNoise2DGrid(...)
+	*
+	* @param noise	- the whole grid, the samples of the region are overwritten
+	* @return false, without writing anything, if noise is too small
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	bool UpdateNoise2DGridRegion(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, const FIntPoint regionMin, const FIntPoint regionMax, UPARAM(ref) TArray<float>& noise)
+	{
+		return FillNoise2DGridRegion(origin, step, sizeX, sizeY, FIntRect(regionMin, regionMax), noise);
 	}
 
+	/**
+	* Regenerates a region of a volume filled by FillNoise3DGrid(...), the samples of the region getting the same values and the others left untouched
+	*
+	* @param regionMin	- the first sample of the region, clipped to the volume
+	* @param regionMax	- the sample after the last one of the region on each axis, clipped to the volume
+	* @param outNoise	- the whole volume, at least sizeX * sizeY * sizeZ values, sample (i, j, k) being at index i + (j + k * sizeY) * sizeX
+	* @return false, without writing anything, if outNoise is too small
+	*/
+	bool FillNoise3DGridRegion(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const FIntVector regionMin, const FIntVector regionMax, TArrayView<float> outNoise)
+	{
+		return FillNoiseGridRegion(origin, step, sizeX, sizeY, sizeZ, regionMin, regionMax, true, outNoise);
+	}
 
-	//***********************************************************
-	//*********************     SETTERS     *********************
-	//***********************************************************
+	/**
+	* Same as FillNoise2DGrid(...), quantizing the values straight into 8 bit outputs, e.g. masks, one row of floats at a time instead of a whole float grid.
+	* [rangeMin, rangeMax] is mapped to [0, 255], values outside of it are clamped
+	*
+	* @param outNoise			- at least sizeX * sizeY values, sample (i, j) being written at index i + j * sizeX
+	* @param rangeMin			- the noise value written as 0
+	* @param rangeMax			- the noise value written as 255
+	* @param bReducedPrecision	- whether to skip the octaves changing the output by less than half a level, see SetFractalAmplitudeThreshold(...). Values stay within one level
+	* @return false, without writing anything, if outNoise is too small or the range is empty
+	*/
+	bool FillQuantizedNoise2DGrid(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, TArrayView<uint8> outNoise, const float rangeMin = -1.0f, const float rangeMax = 1.0f, const bool bReducedPrecision = false) const
+	{
+		return FillQuantizedNoiseGrid(FVector(origin.X, origin.Y, 0.0f), FVector(step.X, step.Y, 0.0f), sizeX, sizeY, 1, false, outNoise, rangeMin, rangeMax, bReducedPrecision);
+	}
 
-	/** Set noise type. */
-	UFUNCTION(BlueprintCallable, Category = "Fast Noise|General settings")
-	void SetNoiseType(const EFastNoise_NoiseType noiseType)
-	{
-		switch (noiseType)
-		{
-		case EFastNoise_NoiseType::Value:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::Value);
-			break;
-		case EFastNoise_NoiseType::ValueFractal:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::ValueFractal);
-			break;
-		case EFastNoise_NoiseType::Perlin:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::Perlin);
-			break;
-		case EFastNoise_NoiseType::PerlinFractal:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::PerlinFractal);
-			break;
-		case EFastNoise_NoiseType::SimplexFractal:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::SimplexFractal);
-			break;
-		case EFastNoise_NoiseType::Cellular:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::Cellular);
-			break;
-		case EFastNoise_NoiseType::WhiteNoise:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::WhiteNoise);
-			break;
-		case EFastNoise_NoiseType::Cubic:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::Cubic);
-			break;
-		case EFastNoise_NoiseType::CubicFractal:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::CubicFractal);
-			break;
-		case EFastNoise_NoiseType::Simplex:
-		default:
-			fastNoise.SetNoiseType(FastNoise::NoiseType::Simplex);
-		}
+	/** Same as above with 16 bit outputs, [rangeMin, rangeMax] being mapped to [0, 65535] */
+	bool FillQuantizedNoise2DGrid(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, TArrayView<uint16> outNoise, const float rangeMin = -1.0f, const float rangeMax = 1.0f, const bool bReducedPrecision = false) const
+	{
+		return FillQuantizedNoiseGrid(FVector(origin.X, origin.Y, 0.0f), FVector(step.X, step.Y, 0.0f), sizeX, sizeY, 1, false, outNoise, rangeMin, rangeMax, bReducedPrecision);
 	}
 
-	/** Set seed. */
-	UFUNCTION(BlueprintCallable, Category = "Fast Noise|General settings")
-	void SetSeed(const int32 seed) { fastNoise.SetSeed(seed); }
+	/** Same as above with half float outputs, [rangeMin, rangeMax] being mapped to [0, 1] without clamping. A [0, 1] range keeps the noise values */
+	bool FillQuantizedNoise2DGrid(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, TArrayView<FFloat16> outNoise, const float rangeMin = -1.0f, const float rangeMax = 1.0f, const bool bReducedPrecision = false) const
+	{
+		return FillQuantizedNoiseGrid(FVector(origin.X, origin.Y, 0.0f), FVector(step.X, step.Y, 0.0f), sizeX, sizeY, 1, false, outNoise, rangeMin, rangeMax, bReducedPrecision);
+	}
 
-	/** Set frequency. */
-	UFUNCTION(BlueprintCallable, Category = "Fast Noise|General settings")
-	void SetFrequency(const float frequency) { fastNoise.SetFrequency(frequency); }
+	/**
+	* Same as FillNoise3DGrid(...), quantizing the values straight into 8 bit outputs, one row of floats at a time instead of a whole float volume.
+	* [rangeMin, rangeMax] is mapped to [0, 255], values outside of it are clamped
+	*
+	* @param outNoise			- at least sizeX * sizeY * sizeZ values, sample (i, j, k) being written at index i + (j + k * sizeY) * sizeX
+	* @param rangeMin			- the noise value written as 0
+	* @param rangeMax			- the noise value written as 255
+	* @param bReducedPrecision	- whether to skip the octaves changing the output by less than half a level, see SetFractalAmplitudeThreshold(...). Values stay within one level
+	* @return false, without writing anything, if outNoise is too small or the range is empty
+	*/
+	bool FillQuantizedNoise3DGrid(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArrayView<uint8> outNoise, const float rangeMin = -1.0f, const float rangeMax = 1.0f, const bool bReducedPrecision = false) const
+	{
+		return FillQuantizedNoiseGrid(origin, step, sizeX, sizeY, sizeZ, true, outNoise, rangeMin, rangeMax, bReducedPrecision);
+	}
 
-	/** Set interpolation type. */
-	UFUNCTION(BlueprintCallable, Category = "Fast Noise|General settings")
-	void SetInterpolation(const EFastNoise_Interp interp)
+	/** Same as above with 16 bit outputs, [rangeMin, rangeMax] being mapped to [0, 65535] */
+	bool FillQuantizedNoise3DGrid(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArrayView<uint16> outNoise, const float rangeMin = -1.0f, const float rangeMax = 1.0f, const bool bReducedPrecision = false) const
 	{
-		switch (interp)
-		{
-		case EFastNoise_Interp::Linear:
-			fastNoise.SetInterp(FastNoise::Interp::Linear);
-			break;
-		case EFastNoise_Interp::Hermite:
-			fastNoise.SetInterp(FastNoise::Interp::Hermite);
-			break;
-		case EFastNoise_Interp::Quintic:
-		default:
-			fastNoise.SetInterp(FastNoise::Interp::Quintic);
-		}
+		return FillQuantizedNoiseGrid(origin, step, sizeX, sizeY, sizeZ, true, outNoise, rangeMin, rangeMax, bReducedPrecision);
 	}
 
-	/** Set fractal type. */
-	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Fractal settings")
-	void SetFractalType(const EFastNoise_FractalType fractalType)
-	{ 
-		switch (fractalType)
-		{
-		case EFastNoise_FractalType::Billow:
-			fastNoise.SetFractalType(FastNoise::FractalType::Billow);
-			break;
-		case EFastNoise_FractalType::RigidMulti:
-			fastNoise.SetFractalType(FastNoise::FractalType::RigidMulti);
-			break;
-		case EFastNoise_FractalType::FBM:
-		default:
-			fastNoise.SetFractalType(FastNoise::FractalType::FBM);
-		}
+	/** Same as above with half float outputs, [rangeMin, rangeMax] being mapped to [0, 1] without clamping. A [0, 1] range keeps the noise values */
+	bool FillQuantizedNoise3DGrid(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArrayView<FFloat16> outNoise, const float rangeMin = -1.0f, const float rangeMax = 1.0f, const bool bReducedPrecision = false) const
+	{
+		return FillQuantizedNoiseGrid(origin, step, sizeX, sizeY, sizeZ, true, outNoise, rangeMin, rangeMax, bReducedPrecision);
 	}
 
-	/** Set fractal octaves. */
-	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Fractal settings")
-	void SetOctaves(const int32 octaves) { fastNoise.SetFractalOctaves(octaves); }
+	/**
+	* Fills a grid of noise values wrapping around on both axes, for tileable textures and wrap-around maps without blending the seams.
+	* The grid is a torus in 4D Simplex noise, each axis going once around a circle of circumference period, so the noise has the same
+	* feature size as GetNoise2DGrid(...) with a step of period / size. Only Simplex and SimplexFractal are tileable
+	*
+	* @param sizeX		- the number of samples along x
+	* @param sizeY		- the number of samples along y
+	* @param period		- the distance covered by the grid on each axis before it repeats
+	* @param outNoise	- the sizeX * sizeY noise values, sample (i, j) being at index i + j * sizeX
+	* @return false, with the values set to 0, for the noise types without a 4D version
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	bool GetTileableNoise2DGrid(const int32 sizeX, const int32 sizeY, const FVector2D period, TArray<float>& outNoise)
+	{
+		outNoise.SetNumUninitialized(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0));
+		return FillTileableNoise2DGrid(sizeX, sizeY, period, outNoise);
+	}
 
-	/** Set fractal lacunarity. */
-	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Fractal settings")
-	void SetLacunarity(const float lacunarity) { fastNoise.SetFractalLacunarity(lacunarity); }
+	/**
+	* Same as GetTileableNoise2DGrid(...), writing into memory owned by the caller instead of allocating
+	*
+	* @param outNoise	- at least sizeX * sizeY values, sample (i, j) being written at index i + j * sizeX
+	* @return false if outNoise is too small, without writing anything, or if the noise type has no 4D version, with the values set to 0
+	*/
+	bool FillTileableNoise2DGrid(const int32 sizeX, const int32 sizeY, const FVector2D period, TArrayView<float> outNoise)
+	{
+		const int32 numSamples = FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0);
 
-	/** Set fractal gain. */
-	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Fractal settings")
-	void SetGain(const float gain) { fastNoise.SetFractalGain(gain); }
+		if (outNoise.Num() < numSamples)
+		{
+			return false;
+		}
 
-	/** Set cellular jitter. */
+		SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+		TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_FillTileableNoise2DGrid);
+
+		if (IsInitialized() && fastNoise.FillTileableNoiseSet2D(outNoise.GetData(), sizeX, sizeY, period.X, period.Y))
+		{
+			FastNoiseStats::AddSamples(fastNoise.GetNoiseType(), numSamples);
+			return true;
+		}
+
+		FMemory::Memzero(outNoise.GetData(), numSamples * sizeof(float));
+		return false;
+	}
+
+	/**
+	* Warps a position using gradient perturbation (domain warp), the warped position can then be used to get noise.
+	* Uses the frequency, interpolation and gradient perturb amp of this wrapper, and the fractal settings when bFractal is set
+	*
+	* @param position	- the x and y values to warp
+	* @param bFractal	- whether to use the fractal version, adding one perturbation per octave
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	FVector2D GradientPerturb2D(const FVector2D position, const bool bFractal = false)
+	{
+		FN_DECIMAL x = position.X;
+		FN_DECIMAL y = position.Y;
+
+		if (IsInitialized() && bFractal)
+		{
+			fastNoise.GradientPerturbFractal(x, y);
+		}
+		else if (IsInitialized())
+		{
+			fastNoise.GradientPerturb(x, y);
+		}
+
+		return FVector2D(x, y);
+	}
+
+	/**
+	* Warps a position using gradient perturbation (domain warp), the warped position can then be used to get noise.
+	* Uses the frequency, interpolation and gradient perturb amp of this wrapper, and the fractal settings when bFractal is set
+	*
+	* @param position	- the x, y and z values to warp
+	* @param bFractal	- whether to use the fractal version, adding one perturbation per octave
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	FVector GradientPerturb3D(const FVector position, const bool bFractal = false)
+	{
+		FN_DECIMAL x = position.X;
+		FN_DECIMAL y = position.Y;
+		FN_DECIMAL z = position.Z;
+
+		if (IsInitialized() && bFractal)
+		{
+			fastNoise.GradientPerturbFractal(x, y, z);
+		}
+		else if (IsInitialized())
+		{
+			fastNoise.GradientPerturb(x, y, z);
+		}
+
+		return FVector(x, y, z);
+	}
+
+	/**
+	* Same as GetNoise2DGrid(...), warping every sample position with GradientPerturb2D(...) first.
+	* Each warped position feeds the noise right away instead of going through blueprints
+	*
+	* @param warpNoise		- wrapper whose settings are used for the warp, this wrapper when none is given
+	* @param bFractalWarp	- whether to use the fractal version of the warp
+	* @param origin			- the x and y values of the first sample, before warping
+	* @param step			- the distance between two consecutive samples on each axis, before warping
+	* @param sizeX			- the number of samples along x
+	* @param sizeY			- the number of samples along y
+	* @param outNoise		- the sizeX * sizeY noise values, sample (i, j) being at index i + j * sizeX
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	void GetWarpedNoise2DGrid(UFastNoiseWrapper* warpNoise, const bool bFractalWarp, const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, TArray<float>& outNoise)
+	{
+		outNoise.SetNumUninitialized(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0));
+
+		if (IsInitialized())
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+			TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_GetWarpedNoise2DGrid);
+			FastNoiseStats::AddSamples(fastNoise.GetNoiseType(), outNoise.Num());
+
+			const FastNoise& warp = (warpNoise && warpNoise->IsInitialized()) ? warpNoise->fastNoise : fastNoise;
+			fastNoise.FillWarpedNoiseSet2D(outNoise.GetData(), warp, bFractalWarp, origin.X, origin.Y, sizeX, sizeY, step.X, step.Y);
+		}
+		else
+		{
+			FMemory::Memzero(outNoise.GetData(), outNoise.Num() * sizeof(float));
+		}
+	}
+
+	/**
+	* Same as GetNoise3DGrid(...), warping every sample position with GradientPerturb3D(...) first.
+	* Each warped position feeds the noise right away instead of going through blueprints
+	*
+	* @param warpNoise		- wrapper whose settings are used for the warp, this wrapper when none is given
+	* @param bFractalWarp	- whether to use the fractal version of the warp
+	* @param origin			- the x, y and z values of the first sample, before warping
+	* @param step			- the distance between two consecutive samples on each axis, before warping
+	* @param sizeX			- the number of samples along x
+	* @param sizeY			- the number of samples along y
+	* @param sizeZ			- the number of samples along z
+	* @param outNoise		- the sizeX * sizeY * sizeZ noise values, sample (i, j, k) being at index i + (j + k * sizeY) * sizeX
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	void GetWarpedNoise3DGrid(UFastNoiseWrapper* warpNoise, const bool bFractalWarp, const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArray<float>& outNoise)
+	{
+		outNoise.SetNumUninitialized(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0));
+
+		if (IsInitialized())
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+			TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_GetWarpedNoise3DGrid);
+			FastNoiseStats::AddSamples(fastNoise.GetNoiseType(), outNoise.Num());
+
+			const FastNoise& warp = (warpNoise && warpNoise->IsInitialized()) ? warpNoise->fastNoise : fastNoise;
+			fastNoise.FillWarpedNoiseSet3D(outNoise.GetData(), warp, bFractalWarp, origin.X, origin.Y, origin.Z, sizeX, sizeY, sizeZ, step.X, step.Y, step.Z);
+		}
+		else
+		{
+			FMemory::Memzero(outNoise.GetData(), outNoise.Num() * sizeof(float));
+		}
+	}
+
+	/**
+	* Generates the same grid as GetNoise2DGrid(...) on the task graph, without blocking the calling thread.
+	* The grid is split in tiles of AsyncTileSamples samples that are distributed among the worker threads.
+	* The settings are copied when the function is called, changing them afterwards doesn't affect the generation
+	*
+	* @param origin		- the x and y values of the first sample
+	* @param step		- the distance between two consecutive samples on each axis
+	* @param sizeX		- the number of samples along x
+	* @param sizeY		- the number of samples along y
+	* @param bAllowGPU	- whether grids of at least GPUMinSamples samples can be generated by the compute shader, matching the CPU within floating point tolerance
+	* @return a future holding the sizeX * sizeY noise values, sample (i, j) being at index i + j * sizeX
+	*/
+	TFuture<TArray<float>> GetNoise2DGridAsync(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, const bool bAllowGPU = false)
+	{
+		const FVector origin3D(origin.X, origin.Y, 0.0f);
+		const FVector step3D(step.X, step.Y, 0.0f);
+
+		return GetNoiseGridAsync(origin3D, step3D, sizeX, sizeY, 1, false, bAllowGPU);
+	}
+
+	/**
+	* Generates the same volume as GetNoise3DGrid(...) on the task graph, without blocking the calling thread.
+	* The volume is split in tiles of AsyncTileSamples samples that are distributed among the worker threads.
+	* The settings are copied when the function is called, changing them afterwards doesn't affect the generation
+	*
+	* @param origin		- the x, y and z values of the first sample
+	* @param step		- the distance between two consecutive samples on each axis
+	* @param sizeX		- the number of samples along x
+	* @param sizeY		- the number of samples along y
+	* @param sizeZ		- the number of samples along z
+	* @param bAllowGPU	- whether volumes of at least GPUMinSamples samples can be generated by the compute shader, matching the CPU within floating point tolerance
+	* @return a future holding the sizeX * sizeY * sizeZ noise values, sample (i, j, k) being at index i + (j + k * sizeY) * sizeX
+	*/
+	TFuture<TArray<float>> GetNoise3DGridAsync(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool bAllowGPU = false)
+	{
+		return GetNoiseGridAsync(origin, step, sizeX, sizeY, sizeZ, true, bAllowGPU);
+	}
+
+	/**
+	* Same as GetNoise2DGridAsync(...) on the CPU, writing into memory owned by the caller, which must stay valid until the future is ready
+	*
+	* @param outNoise	- at least sizeX * sizeY values, sample (i, j) being written at index i + j * sizeX
+	* @return a future holding false, without anything written, if outNoise is too small
+	*/
+	TFuture<bool> FillNoise2DGridAsync(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, TArrayView<float> outNoise)
+	{
+		return FillNoiseGridAsync(FVector(origin.X, origin.Y, 0.0f), FVector(step.X, step.Y, 0.0f), sizeX, sizeY, 1, false, outNoise);
+	}
+
+	/**
+	* Same as GetNoise3DGridAsync(...) on the CPU, writing into memory owned by the caller, which must stay valid until the future is ready
+	*
+	* @param outNoise	- at least sizeX * sizeY * sizeZ values, sample (i, j, k) being written at index i + (j + k * sizeY) * sizeX
+	* @return a future holding false, without anything written, if outNoise is too small
+	*/
+	TFuture<bool> FillNoise3DGridAsync(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, TArrayView<float> outNoise)
+	{
+		return FillNoiseGridAsync(origin, step, sizeX, sizeY, sizeZ, true, outNoise);
+	}
+
+	/**
+	* Same as FillNoise2DGridRegion(...) on the task graph, e.g. regenerating the visible part of a preview first and the rest afterwards.
+	* The settings are copied when the function is called, and outNoise must stay valid until the future is ready
+	*
+	* @return a future holding false, without anything written, if outNoise is too small
+	*/
+	TFuture<bool> FillNoise2DGridRegionAsync(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, const FIntRect& region, TArrayView<float> outNoise)
+	{
+		return FillNoiseGridRegionAsync(FVector(origin.X, origin.Y, 0.0f), FVector(step.X, step.Y, 0.0f), sizeX, sizeY, 1, FIntVector(region.Min.X, region.Min.Y, 0), FIntVector(region.Max.X, region.Max.Y, 1), false, outNoise);
+	}
+
+	/** Same as FillNoise3DGridRegion(...) on the task graph, outNoise must stay valid until the future is ready */
+	TFuture<bool> FillNoise3DGridRegionAsync(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const FIntVector regionMin, const FIntVector regionMax, TArrayView<float> outNoise)
+	{
+		return FillNoiseGridRegionAsync(origin, step, sizeX, sizeY, sizeZ, regionMin, regionMax, true, outNoise);
+	}
+
+	/** Approximate number of samples generated by each task of the async grid functions, 64KB of output so a tile stays in the L2 cache */
+	static constexpr int32 AsyncTileSamples = 16384;
+
+	/** Minimum number of samples of the async grid functions to use the GPU when allowed, below it uploading the tables and reading back costs more than the CPU */
+	static constexpr int32 GPUMinSamples = 1024 * 1024;
+
+	/**
+	* Creates a transient texture filled with the same grid as GetNoise2DGrid(...), one texel per sample
+	*
+	* @param origin		- the x and y values of the first texel
+	* @param step		- the distance between two consecutive texels on each axis
+	* @param sizeX		- the texture width
+	* @param sizeY		- the texture height
+	* @param format		- the texel format. R8 maps the noise from [-1, 1] to [0, 255]
+	* @param bRemap		- whether to map the noise from [-1, 1] to [0, 1] in the float formats, R8 is always remapped
+	* @return the texture, or null if the size is not valid
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	UTexture2D* CreateNoiseTexture2D(const FVector2D origin, const FVector2D step, const int32 sizeX, const int32 sizeY, const EFastNoise_TextureFormat format = EFastNoise_TextureFormat::R8, const bool bRemap = true)
+	{
+		if (sizeX <= 0 || sizeY <= 0)
+		{
+			return nullptr;
+		}
+
+		UTexture2D* texture = UTexture2D::CreateTransient(sizeX, sizeY, GetPixelFormat(format));
+
+		if (texture)
+		{
+			texture->SRGB = false;
+			FillNoiseTexture2D(texture, origin, step, bRemap);
+		}
+
+		return texture;
+	}
+
+	/**
+	* Fills the first mip of a texture with the same grid as GetNoise2DGrid(...), one texel per sample.
+	* The noise is written straight into the locked mip, the texture must be uncompressed G8, R16F or R32F with its source data available, like transient textures
+	*
+	* @param texture	- the texture to fill, one sample per texel of its first mip
+	* @param origin		- the x and y values of the first texel
+	* @param step		- the distance between two consecutive texels on each axis
+	* @param bRemap		- whether to map the noise from [-1, 1] to [0, 1] in the float formats, G8 is always remapped
+	* @return whether the texture could be filled
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	bool FillNoiseTexture2D(UTexture2D* texture, const FVector2D origin, const FVector2D step, const bool bRemap = true)
+	{
+		EFastNoise_TextureFormat format;
+
+		if (!texture || !texture->PlatformData || texture->PlatformData->Mips.Num() == 0 || !GetTextureFormat(texture->PlatformData->PixelFormat, format))
+		{
+			return false;
+		}
+
+		FTexture2DMipMap& mip = texture->PlatformData->Mips[0];
+		uint8* texels = static_cast<uint8*>(mip.BulkData.Lock(LOCK_READ_WRITE));
+
+		if (!texels)
+		{
+			mip.BulkData.Unlock();
+			return false;
+		}
+
+		FillTexels(texels, mip.SizeX * GetBytesPerTexel(format), format, bRemap, origin, step, mip.SizeX, mip.SizeY);
+
+		mip.BulkData.Unlock();
+		texture->UpdateResource();
+
+		return true;
+	}
+
+	/**
+	* Fills a render target with the same grid as GetNoise2DGrid(...), one texel per sample.
+	* The noise is written in a staging buffer uploaded to the GPU in one go, the render target format must be R8, R16f or R32f
+	*
+	* @param renderTarget	- the render target to fill, one sample per texel
+	* @param origin			- the x and y values of the first texel
+	* @param step			- the distance between two consecutive texels on each axis
+	* @param bRemap			- whether to map the noise from [-1, 1] to [0, 1] in the float formats, R8 is always remapped
+	* @return whether the render target could be filled
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise")
+	bool FillNoiseRenderTarget2D(UTextureRenderTarget2D* renderTarget, const FVector2D origin, const FVector2D step, const bool bRemap = true)
+	{
+		EFastNoise_TextureFormat format;
+
+		if (!renderTarget || renderTarget->SizeX <= 0 || renderTarget->SizeY <= 0 || !GetTextureFormat(renderTarget->GetFormat(), format))
+		{
+			return false;
+		}
+
+		FTextureRenderTargetResource* resource = renderTarget->GameThread_GetRenderTargetResource();
+
+		if (!resource)
+		{
+			return false;
+		}
+
+		const int32 sizeX = renderTarget->SizeX;
+		const int32 sizeY = renderTarget->SizeY;
+		const int32 rowPitch = sizeX * GetBytesPerTexel(format);
+
+		TArray<uint8> texels;
+		texels.SetNumUninitialized(rowPitch * sizeY);
+		FillTexels(texels.GetData(), rowPitch, format, bRemap, origin, step, sizeX, sizeY);
+
+		ENQUEUE_RENDER_COMMAND(FastNoiseFillRenderTarget)([resource, texels = MoveTemp(texels), rowPitch, sizeX, sizeY](FRHICommandListImmediate& RHICmdList)
+		{
+			const FUpdateTextureRegion2D region(0, 0, 0, 0, sizeX, sizeY);
+			RHIUpdateTexture2D(resource->GetRenderTargetTexture(), 0, region, rowPitch, texels.GetData());
+		});
+
+		return true;
+	}
+
+
+	//***********************************************************
+	//*********************     GETTERS     *********************
+	//***********************************************************
+
+	/** Gets noise type */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|General settings")
+	EFastNoise_NoiseType GetNoiseType() { return FastNoiseSettings::FromFastNoise(fastNoise.GetNoiseType()); }
+
+	/** Gets seed. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|General settings")
+	int32 GetSeed() { return fastNoise.GetSeed(); }
+
+	/** Gets frequency. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|General settings")
+	float GetFrequency() { return fastNoise.GetFrequency(); }
+
+	/** Gets interpolation type. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|General settings")
+	EFastNoise_Interp GetInterpolation() { return FastNoiseSettings::FromFastNoise(fastNoise.GetInterp()); }
+
+	/** Gets index mode. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|General settings")
+	EFastNoise_IndexMode GetIndexMode() { return FastNoiseSettings::FromFastNoise(fastNoise.GetIndexMode()); }
+
+	/** Gets fractal type. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
+	EFastNoise_FractalType GetFractalType() { return FastNoiseSettings::FromFastNoise(fastNoise.GetFractalType()); }
+
+	/** Gets fractal octaves. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
+	int32 GetOctaves() { return fastNoise.GetFractalOctaves(); }
+
+	/** Gets fractal lacunarity. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
+	float GetLacunarity() { return fastNoise.GetFractalLacunarity(); }
+
+	/** Gets fractal gain. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
+	float GetGain() { return fastNoise.GetFractalGain(); }
+
+	/** Gets fractal amplitude threshold. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
+	float GetFractalAmplitudeThreshold() { return fastNoise.GetFractalAmplitudeThreshold(); }
+
+	/** Gets the number of octaves evaluated once the amplitude threshold is applied. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Fractal settings")
+	int32 GetOctavesEvaluated() { return fastNoise.GetFractalOctavesEvaluated(); }
+
+	/** Gets cellular jitter. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Cellular settings")
+	float GetCellularJitter() { return fastNoise.GetCellularJitter(); }
+
+	/** Gets cellular distance function. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Cellular settings")
+	EFastNoise_CellularDistanceFunction GetDistanceFunction() { return FastNoiseSettings::FromFastNoise(fastNoise.GetCellularDistanceFunction()); }
+
+	/** Gets cellular return type. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Cellular settings")
+	EFastNoise_CellularReturnType GetReturnType() { return FastNoiseSettings::FromFastNoise(fastNoise.GetCellularReturnType()); }
+
+	/** Gets gradient perturb amp. */
+	UFUNCTION(BlueprintPure, Category = "Fast Noise|Gradient perturb settings")
+	float GetGradientPerturbAmp() { return fastNoise.GetGradientPerturbAmp(); }
+
+
+	//***********************************************************
+	//*********************     SETTERS     *********************
+	//***********************************************************
+
+	/** Set noise type. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|General settings")
+	void SetNoiseType(const EFastNoise_NoiseType noiseType) { fastNoise.SetNoiseType(FastNoiseSettings::ToFastNoise(noiseType)); PublishSnapshot(); }
+
+	/** Set seed. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|General settings")
+	void SetSeed(const int32 seed) { fastNoise.SetSeed(seed); PublishSnapshot(); }
+
+	/** Set frequency. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|General settings")
+	void SetFrequency(const float frequency) { fastNoise.SetFrequency(frequency); PublishSnapshot(); }
+
+	/** Set interpolation type. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|General settings")
+	void SetInterpolation(const EFastNoise_Interp interp) { fastNoise.SetInterp(FastNoiseSettings::ToFastNoise(interp)); PublishSnapshot(); }
+
+	/**
+	* Set index mode, how lattice coordinates are hashed into gradient and value indices.
+	* IntegerHash hashes with integer multiplies instead of the permutation tables of the seed, so the noise differs from PermutationTable.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|General settings")
+	void SetIndexMode(const EFastNoise_IndexMode indexMode) { fastNoise.SetIndexMode(FastNoiseSettings::ToFastNoise(indexMode)); PublishSnapshot(); }
+
+	/** Set fractal type. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Fractal settings")
+	void SetFractalType(const EFastNoise_FractalType fractalType) { fastNoise.SetFractalType(FastNoiseSettings::ToFastNoise(fractalType)); PublishSnapshot(); }
+
+	/** Set fractal octaves. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Fractal settings")
+	void SetOctaves(const int32 octaves) { fastNoise.SetFractalOctaves(octaves); PublishSnapshot(); }
+
+	/** Set fractal lacunarity. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Fractal settings")
+	void SetLacunarity(const float lacunarity) { fastNoise.SetFractalLacunarity(lacunarity); PublishSnapshot(); }
+
+	/** Set fractal gain. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Fractal settings")
+	void SetGain(const float gain) { fastNoise.SetFractalGain(gain); PublishSnapshot(); }
+
+	/**
+	* Set fractal amplitude threshold, the largest change to the noise allowed by skipping the highest octaves.
+	* 0 evaluates every octave, 1/255 keeps 8 bit textures within one level of the full noise.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Fractal settings")
+	void SetFractalAmplitudeThreshold(const float threshold) { fastNoise.SetFractalAmplitudeThreshold(threshold); PublishSnapshot(); }
+
+	/** Set cellular jitter. */
 	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Cellular settings")
-	void SetCellularJitter(const float cellularJitter) { fastNoise.SetCellularJitter(cellularJitter); }
+	void SetCellularJitter(const float cellularJitter) { fastNoise.SetCellularJitter(cellularJitter); PublishSnapshot(); }
 
 	/** Set cellular distance function. */
 	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Cellular settings")
-	void SetDistanceFunction(const EFastNoise_CellularDistanceFunction distanceFunction)
+	void SetDistanceFunction(const EFastNoise_CellularDistanceFunction distanceFunction) { fastNoise.SetCellularDistanceFunction(FastNoiseSettings::ToFastNoise(distanceFunction)); PublishSnapshot(); }
+
+	/** Set cellular return type. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Cellular settings")
+	void SetReturnType(const EFastNoise_CellularReturnType cellularReturnType) { fastNoise.SetCellularReturnType(FastNoiseSettings::ToFastNoise(cellularReturnType)); PublishSnapshot(); }
+
+	/**
+	* Set the noise returned at the closest cell by the NoiseLookup cellular return type, cells return 0 without one.
+	* The current settings of the lookup are copied, call it again after changing them
+	*
+	* @param noiseLookup	- the noise sampled at the cell positions, nullptr to clear it
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Cellular settings")
+	void SetCellularNoiseLookup(UFastNoiseWrapper* noiseLookup)
 	{
-		switch (distanceFunction)
+		cellularNoiseLookup = (noiseLookup && noiseLookup->IsInitialized()) ? noiseLookup->GetSnapshot() : TSharedPtr<const FastNoise, ESPMode::ThreadSafe>();
+		fastNoise.SetCellularNoiseLookup(cellularNoiseLookup.Get());
+		PublishSnapshot();
+	}
+
+	/** Set gradient perturb amp. */
+	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Gradient perturb settings")
+	void SetGradientPerturbAmp(const float gradientPerturbAmp) { fastNoise.SetGradientPerturbAmp(gradientPerturbAmp); PublishSnapshot(); }
+
+private:
+
+	TFuture<TArray<float>> GetNoiseGridAsync(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D, const bool bAllowGPU)
+	{
+		// FastNoise is only read while sampling, so the snapshot can be shared by all the tasks
+		const TSharedRef<const FastNoise, ESPMode::ThreadSafe> noise = GetSnapshot();
+		const bool bNoiseInitialized = IsInitialized();
+
+		if (bAllowGPU && bNoiseInitialized && int64(sizeX) * sizeY * sizeZ >= GPUMinSamples && FFastNoiseCompute::IsSupported(*noise))
 		{
-		case EFastNoise_CellularDistanceFunction::Manhattan:
-			fastNoise.SetCellularDistanceFunction(FastNoise::CellularDistanceFunction::Manhattan);
-			break;
-		case EFastNoise_CellularDistanceFunction::Natural:
-			fastNoise.SetCellularDistanceFunction(FastNoise::CellularDistanceFunction::Natural);
-			break;
-		case EFastNoise_CellularDistanceFunction::Euclidean:
-		default:
-			fastNoise.SetCellularDistanceFunction(FastNoise::CellularDistanceFunction::Euclidean);
+			return FFastNoiseCompute::GenerateAsync(*noise, origin, step, sizeX, sizeY, sizeZ, b3D);
 		}
+
+		INC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+
+		return Async(EAsyncExecution::TaskGraph, [noise, bNoiseInitialized, origin, step, sizeX, sizeY, sizeZ, b3D]()
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FastNoise_AsyncJob);
+			TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_GetNoiseGridAsync);
+
+			TArray<float> outNoise;
+			outNoise.SetNumUninitialized(FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0));
+
+			if (!bNoiseInitialized)
+			{
+				FMemory::Memzero(outNoise.GetData(), outNoise.Num() * sizeof(float));
+			}
+			else if (outNoise.Num() > 0)
+			{
+				FastNoiseStats::AddSamples(noise->GetNoiseType(), outNoise.Num());
+				ParallelFillNoiseGrid(*noise, outNoise.GetData(), origin, step, sizeX, sizeY, sizeZ, b3D);
+			}
+
+			DEC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+			return outNoise;
+		});
 	}
 
-	/** Set cellular return type. */
-	UFUNCTION(BlueprintCallable, Category = "Fast Noise|Cellular settings")
-	void SetReturnType(const EFastNoise_CellularReturnType cellularReturnType)
-	{
-		switch (cellularReturnType)
-		{
-		/*case EFastNoise_CellularReturnType::NoiseLookup:
-			fastNoise.SetCellularReturnType(FastNoise::CellularReturnType::NoiseLookup);
-			break;*/
-		case EFastNoise_CellularReturnType::Distance:
-			fastNoise.SetCellularReturnType(FastNoise::CellularReturnType::Distance);
-			break;
-		case EFastNoise_CellularReturnType::Distance2:
-			fastNoise.SetCellularReturnType(FastNoise::CellularReturnType::Distance2);
-			break;
-		case EFastNoise_CellularReturnType::Distance2Add:
-			fastNoise.SetCellularReturnType(FastNoise::CellularReturnType::Distance2Add);
-			break;
-		case EFastNoise_CellularReturnType::Distance2Sub:
-			fastNoise.SetCellularReturnType(FastNoise::CellularReturnType::Distance2Sub);
-			break;
-		case EFastNoise_CellularReturnType::Distance2Mul:
-			fastNoise.SetCellularReturnType(FastNoise::CellularReturnType::Distance2Mul);
-			break;
-		case EFastNoise_CellularReturnType::Distance2Div:
-			fastNoise.SetCellularReturnType(FastNoise::CellularReturnType::Distance2Div);
-			break;
-		case EFastNoise_CellularReturnType::CellValue:
-		default:
-			fastNoise.SetCellularReturnType(FastNoise::CellularReturnType::CellValue);
+	TFuture<bool> FillNoiseGridAsync(const FVector origin, const FVector step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D, TArrayView<float> outNoise)
+	{
+		const TSharedRef<const FastNoise, ESPMode::ThreadSafe> noise = GetSnapshot();
+		const bool bNoiseInitialized = IsInitialized();
+
+		INC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+
+		return Async(EAsyncExecution::TaskGraph, [noise, bNoiseInitialized, origin, step, sizeX, sizeY, sizeZ, b3D, outNoise]()
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FastNoise_AsyncJob);
+			TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_FillNoiseGridAsync);
+
+			const int32 numSamples = FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0);
+
+			if (outNoise.Num() < numSamples)
+			{
+				DEC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+				return false;
+			}
+
+			if (!bNoiseInitialized)
+			{
+				FMemory::Memzero(outNoise.GetData(), numSamples * sizeof(float));
+			}
+			else if (numSamples > 0)
+			{
+				FastNoiseStats::AddSamples(noise->GetNoiseType(), numSamples);
+				ParallelFillNoiseGrid(*noise, outNoise.GetData(), origin, step, sizeX, sizeY, sizeZ, b3D);
+			}
+
+			DEC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+			return true;
+		});
+	}
+
+	/** Fills a grid with ParallelFor, each task generating whole rows so the values match the single threaded grid functions */
+	static void ParallelFillNoiseGrid(const FastNoise& noise, float* outNoise, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D)
+	{
+		const int32 numRows = sizeY * sizeZ;
+		const int32 rowsPerTile = FMath::Max(1, AsyncTileSamples / sizeX);
+		const int32 numTiles = FMath::DivideAndRoundUp(numRows, rowsPerTile);
+
+		ParallelFor(numTiles, [&](const int32 tile)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_AsyncTile);
+
+			const int32 lastRow = FMath::Min(numRows, (tile + 1) * rowsPerTile);
+
+			for (int32 row = tile * rowsPerTile; row < lastRow; row++)
+			{
+				const int32 j = row % sizeY;
+				const int32 k = row / sizeY;
+				float* rowNoise = outNoise + row * sizeX;
+
+				if (b3D)
+				{
+					noise.FillNoiseSet3D(rowNoise, origin.X, origin.Y + j * step.Y, origin.Z + k * step.Z, sizeX, 1, 1, step.X, step.Y, step.Z);
+				}
+				else
+				{
+					noise.FillNoiseSet2D(rowNoise, origin.X, origin.Y + j * step.Y, sizeX, 1, step.X, step.Y);
+				}
+			}
+		});
+	}
+
+	bool FillNoiseGridRegion(const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const FIntVector& regionMin, const FIntVector& regionMax, const bool b3D, TArrayView<float> outNoise) const
+	{
+		if (outNoise.Num() < FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0))
+		{
+			return false;
 		}
+
+		SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+		TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_FillNoiseGridRegion);
+
+		WriteNoiseGridRegion(bInitialized ? &fastNoise : nullptr, outNoise.GetData(), origin, step, sizeX, sizeY, sizeZ, regionMin, regionMax, b3D, false);
+		return true;
 	}
 
-private:
+	TFuture<bool> FillNoiseGridRegionAsync(const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const FIntVector& regionMin, const FIntVector& regionMax, const bool b3D, TArrayView<float> outNoise)
+	{
+		const TSharedRef<const FastNoise, ESPMode::ThreadSafe> noise = GetSnapshot();
+		const bool bNoiseInitialized = IsInitialized();
 
-	FastNoise fastNoise;
+		INC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+
+		return Async(EAsyncExecution::TaskGraph, [noise, bNoiseInitialized, origin, step, sizeX, sizeY, sizeZ, regionMin, regionMax, b3D, outNoise]()
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FastNoise_AsyncJob);
+			TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_FillNoiseGridRegionAsync);
+
+			const bool bFits = outNoise.Num() >= FMath::Max(sizeX, 0) * FMath::Max(sizeY, 0) * FMath::Max(sizeZ, 0);
+
+			if (bFits)
+			{
+				WriteNoiseGridRegion(bNoiseInitialized ? &noise.Get() : nullptr, outNoise.GetData(), origin, step, sizeX, sizeY, sizeZ, regionMin, regionMax, b3D, true);
+			}
+
+			DEC_DWORD_STAT(STAT_FastNoise_NumAsyncJobs);
+			return bFits;
+		});
+	}
+
+	/**
+	* Writes the samples of a region clipped to the grid, set to 0 without noise. The positions are computed from the grid origin like the
+	* grid functions compute them and sampled as scattered positions, so the values match the whole grid exactly
+	*/
+	static void WriteNoiseGridRegion(const FastNoise* noise, float* outNoise, const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const FIntVector& regionMin, const FIntVector& regionMax, const bool b3D, const bool bParallel)
+	{
+		const FIntVector first(FMath::Max(regionMin.X, 0), FMath::Max(regionMin.Y, 0), FMath::Max(regionMin.Z, 0));
+		const FIntVector last(FMath::Min(regionMax.X, sizeX), FMath::Min(regionMax.Y, sizeY), FMath::Min(regionMax.Z, sizeZ));
+		const int32 width = last.X - first.X;
+		const int32 numRowsY = last.Y - first.Y;
+		const int32 numRows = numRowsY * (last.Z - first.Z);
+
+		if (width <= 0 || numRowsY <= 0 || numRows <= 0)
+		{
+			return;
+		}
+
+		if (noise)
+		{
+			FastNoiseStats::AddSamples(noise->GetNoiseType(), int64(width) * numRows);
+		}
+
+		TArray<float> x;
+		x.SetNumUninitialized(width);
+
+		for (int32 i = 0; i < width; i++)
+		{
+			x[i] = origin.X + (first.X + i) * step.X;
+		}
+
+		const int32 rowsPerTile = FMath::Max(1, AsyncTileSamples / width);
+		const int32 numTiles = FMath::DivideAndRoundUp(numRows, rowsPerTile);
+
+		ParallelFor(numTiles, [&](const int32 tile)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_RegionTile);
+
+			TArray<float> y, z;
+			y.SetNumUninitialized(width);
+			z.SetNumUninitialized(b3D ? width : 0);
+
+			const int32 lastRow = FMath::Min(numRows, (tile + 1) * rowsPerTile);
+
+			for (int32 row = tile * rowsPerTile; row < lastRow; row++)
+			{
+				const int32 j = first.Y + row % numRowsY;
+				const int32 k = first.Z + row / numRowsY;
+				float* rowNoise = outNoise + first.X + (j + k * sizeY) * sizeX;
+
+				if (!noise)
+				{
+					FMemory::Memzero(rowNoise, width * sizeof(float));
+					continue;
+				}
+
+				for (int32 i = 0; i < width; i++)
+				{
+					y[i] = origin.Y + j * step.Y;
+				}
+
+				if (b3D)
+				{
+					for (int32 i = 0; i < width; i++)
+					{
+						z[i] = origin.Z + k * step.Z;
+					}
+
+					noise->FillNoiseSetPoints3D(rowNoise, x.GetData(), y.GetData(), z.GetData(), width);
+				}
+				else
+				{
+					noise->FillNoiseSetPoints2D(rowNoise, x.GetData(), y.GetData(), width);
+				}
+			}
+		}, !bParallel);
+	}
+
+	/** Zeroes the numSamples values of an uninitialized wrapper, false if outNoise is too small */
+	static bool ZeroNoise(const int32 numSamples, TArrayView<float> outNoise)
+	{
+		if (outNoise.Num() < numSamples)
+		{
+			return false;
+		}
+
+		FMemory::Memzero(outNoise.GetData(), numSamples * sizeof(float));
+		return true;
+	}
+
+	/** Fills a quantized grid row by row, the rows matching FillNoise2DGrid/3DGrid(...) before quantization */
+	template <typename OutputType>
+	bool FillQuantizedNoiseGrid(const FVector& origin, const FVector& step, const int32 sizeX, const int32 sizeY, const int32 sizeZ, const bool b3D, TArrayView<OutputType> outNoise, const float rangeMin, const float rangeMax, const bool bReducedPrecision) const
+	{
+		const int32 numRows = FMath::Max(sizeY, 0) * (b3D ? FMath::Max(sizeZ, 0) : 1);
+		const int32 numSamples = FMath::Max(sizeX, 0) * numRows;
+
+		if (outNoise.Num() < numSamples || rangeMax == rangeMin)
+		{
+			return false;
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+		TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_FillQuantizedNoiseGrid);
+
+		if (bInitialized)
+		{
+			FastNoiseStats::AddSamples(fastNoise.GetNoiseType(), numSamples);
+		}
+
+		const float scale = 1.0f / (rangeMax - rangeMin);
+		const float bias = -rangeMin * scale;
+		TArray<float> row;
+		row.SetNumUninitialized(FMath::Max(sizeX, 0));
+
+		// Half a level of the output in noise units, an amplitude threshold stays within one level
+		TOptional<FastNoise> reducedNoise;
+
+		if (bReducedPrecision)
+		{
+			const float threshold = 0.5f * GetQuantizationStep(outNoise.GetData()) * FMath::Abs(rangeMax - rangeMin);
+
+			reducedNoise.Emplace(fastNoise);
+			reducedNoise->SetFractalAmplitudeThreshold(FMath::Max(threshold, float(fastNoise.GetFractalAmplitudeThreshold())));
+		}
+
+		const FastNoise& noise = reducedNoise.IsSet() ? reducedNoise.GetValue() : fastNoise;
+
+		for (int32 rowIndex = 0; rowIndex < numRows && sizeX > 0; rowIndex++)
+		{
+			const int32 j = rowIndex % sizeY;
+			const int32 k = rowIndex / sizeY;
+
+			if (!bInitialized)
+			{
+				FMemory::Memzero(row.GetData(), sizeX * sizeof(float));
+			}
+			else if (b3D)
+			{
+				noise.FillNoiseSet3D(row.GetData(), origin.X, origin.Y + j * step.Y, origin.Z + k * step.Z, sizeX, 1, 1, step.X, step.Y, step.Z);
+			}
+			else
+			{
+				noise.FillNoiseSet2D(row.GetData(), origin.X, origin.Y + j * step.Y, sizeX, 1, step.X, step.Y);
+			}
+
+			QuantizeNoise(row.GetData(), sizeX, scale, bias, outNoise.GetData() + rowIndex * sizeX);
+		}
+
+		return true;
+	}
+
+	/** Writes noise * scale + bias, clamped to [0, 1] and rounded to the nearest level for the integer outputs */
+	static void QuantizeNoise(const float* noise, const int32 num, const float scale, const float bias, uint8* outNoise)
+	{
+		for (int32 i = 0; i < num; i++)
+			outNoise[i] = uint8(FMath::Clamp(noise[i] * scale + bias, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	static void QuantizeNoise(const float* noise, const int32 num, const float scale, const float bias, uint16* outNoise)
+	{
+		for (int32 i = 0; i < num; i++)
+			outNoise[i] = uint16(FMath::Clamp(noise[i] * scale + bias, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+
+	static void QuantizeNoise(const float* noise, const int32 num, const float scale, const float bias, FFloat16* outNoise)
+	{
+		for (int32 i = 0; i < num; i++)
+			outNoise[i] = FFloat16(noise[i] * scale + bias);
+	}
+
+	/** Returns the difference between two consecutive output levels in [0, 1], half floats being taken at their coarsest below 1 */
+	static float GetQuantizationStep(const uint8*) { return 1.0f / 255.0f; }
+	static float GetQuantizationStep(const uint16*) { return 1.0f / 65535.0f; }
+	static float GetQuantizationStep(const FFloat16*) { return 1.0f / 2048.0f; }
+
+	/** Fills sizeY rows of texels, one FillNoiseSet2D(...) call per row so the values match GetNoise2DGrid(...) */
+	void FillTexels(uint8* texels, const int32 rowPitch, const EFastNoise_TextureFormat format, const bool bRemap, const FVector2D& origin, const FVector2D& step, const int32 sizeX, const int32 sizeY) const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FastNoise_Grid);
+		TRACE_CPUPROFILER_EVENT_SCOPE(FastNoise_FillTexels);
+
+		if (bInitialized)
+		{
+			FastNoiseStats::AddSamples(fastNoise.GetNoiseType(), int64(sizeX) * sizeY);
+		}
+
+		// R32F rows without remapping are generated in place, the other formats go through a single row
+		const bool bInPlace = format == EFastNoise_TextureFormat::R32F && !bRemap;
+		TArray<float> row;
+
+		if (!bInPlace)
+		{
+			row.SetNumUninitialized(sizeX);
+		}
+
+		for (int32 j = 0; j < sizeY; j++)
+		{
+			uint8* rowTexels = texels + j * rowPitch;
+			float* rowNoise = bInPlace ? reinterpret_cast<float*>(rowTexels) : row.GetData();
+
+			if (bInitialized)
+			{
+				fastNoise.FillNoiseSet2D(rowNoise, origin.X, origin.Y + j * step.Y, sizeX, 1, step.X, step.Y);
+			}
+			else
+			{
+				FMemory::Memzero(rowNoise, sizeX * sizeof(float));
+			}
+
+			if (bInPlace)
+			{
+				continue;
+			}
+
+			switch (format)
+			{
+			case EFastNoise_TextureFormat::R8:
+				QuantizeNoise(rowNoise, sizeX, 0.5f, 0.5f, rowTexels);
+				break;
+			case EFastNoise_TextureFormat::R16F:
+				QuantizeNoise(rowNoise, sizeX, bRemap ? 0.5f : 1.0f, bRemap ? 0.5f : 0.0f, reinterpret_cast<FFloat16*>(rowTexels));
+				break;
+			case EFastNoise_TextureFormat::R32F:
+				for (int32 i = 0; i < sizeX; i++)
+					reinterpret_cast<float*>(rowTexels)[i] = rowNoise[i] * 0.5f + 0.5f;
+				break;
+			}
+		}
+	}
+
+	static EPixelFormat GetPixelFormat(const EFastNoise_TextureFormat format)
+	{
+		switch (format)
+		{
+		case EFastNoise_TextureFormat::R16F:	return PF_R16F;
+		case EFastNoise_TextureFormat::R32F:	return PF_R32_FLOAT;
+		default:								return PF_G8;
+		}
+	}
+
+	static bool GetTextureFormat(const EPixelFormat pixelFormat, EFastNoise_TextureFormat& outFormat)
+	{
+		switch (pixelFormat)
+		{
+		case PF_G8:			outFormat = EFastNoise_TextureFormat::R8;	return true;
+		case PF_R16F:		outFormat = EFastNoise_TextureFormat::R16F;	return true;
+		case PF_R32_FLOAT:	outFormat = EFastNoise_TextureFormat::R32F;	return true;
+		default:			return false;
+		}
+	}
+
+	static int32 GetBytesPerTexel(const EFastNoise_TextureFormat format)
+	{
+		switch (format)
+		{
+		case EFastNoise_TextureFormat::R16F:	return sizeof(FFloat16);
+		case EFastNoise_TextureFormat::R32F:	return sizeof(float);
+		default:								return sizeof(uint8);
+		}
+	}
+
+	/** Replaces the snapshot returned by GetSnapshot() with a copy of the current settings and updates the cached noise functions */
+	void PublishSnapshot()
+	{
+		noiseFunc2D = fastNoise.GetNoiseFunc2D();
+		noiseFunc3D = fastNoise.GetNoiseFunc3D();
+		settingsHash = FFastNoiseEvaluator::HashSettings(fastNoise);
+
+		// Copy outside of the lock, only the pointer swap is guarded
+		TSharedRef<const FastNoise, ESPMode::ThreadSafe> newSnapshot = CopySettings();
+		TSharedPtr<const FastNoise, ESPMode::ThreadSafe> previousSnapshot;
+		noiseSettings = FFastNoiseSettings::FromFastNoise(fastNoise);
+		evaluator = FFastNoiseEvaluator(newSnapshot);
+
+		{
+			FScopeLock lock(&snapshotLock);
+			previousSnapshot = snapshot;
+			snapshot = newSnapshot;
+			snapshotHash = settingsHash;
+		}
+
+		// Every setting changes the noise when the wrapper gets initialized, the settings of an uninitialized wrapper don't change anything
+		int32 changedSettings = 0;
+
+		if (bInitialized != bSnapshotInitialized)
+		{
+			changedSettings = (1 << NumSettings) - 1;
+		}
+		else if (bInitialized)
+		{
+			changedSettings = previousSnapshot.IsValid() ? GetChangedSettings(*previousSnapshot, fastNoise) : (1 << NumSettings) - 1;
+		}
+
+		bSnapshotInitialized = bInitialized;
+
+		if (changedSettings == 0)
+		{
+			return;
+		}
+
+		settingsVersion++;
+
+		for (int32 setting = 0; setting < NumSettings; setting++)
+		{
+			if (changedSettings & (1 << setting))
+			{
+				settingVersions[setting] = settingsVersion;
+			}
+		}
+
+		OnSettingsChanged.Broadcast(this, changedSettings);
+	}
+
+	/** Returns the mask of the settings differing between two FastNoise */
+	static int32 GetChangedSettings(const FastNoise& previous, const FastNoise& current)
+	{
+		const bool bChanged[NumSettings] =
+		{
+			previous.GetNoiseType() != current.GetNoiseType(),
+			previous.GetSeed() != current.GetSeed(),
+			previous.GetFrequency() != current.GetFrequency(),
+			previous.GetInterp() != current.GetInterp(),
+			previous.GetIndexMode() != current.GetIndexMode(),
+			previous.GetFractalType() != current.GetFractalType(),
+			previous.GetFractalOctaves() != current.GetFractalOctaves(),
+			previous.GetFractalLacunarity() != current.GetFractalLacunarity(),
+			previous.GetFractalGain() != current.GetFractalGain(),
+			previous.GetFractalAmplitudeThreshold() != current.GetFractalAmplitudeThreshold(),
+			previous.GetCellularJitter() != current.GetCellularJitter(),
+			previous.GetCellularDistanceFunction() != current.GetCellularDistanceFunction(),
+			previous.GetCellularReturnType() != current.GetCellularReturnType(),
+			(previous.GetCellularNoiseLookup() ? FFastNoiseEvaluator::HashSettings(*previous.GetCellularNoiseLookup()) : 0) != (current.GetCellularNoiseLookup() ? FFastNoiseEvaluator::HashSettings(*current.GetCellularNoiseLookup()) : 0),
+			previous.GetGradientPerturbAmp() != current.GetGradientPerturbAmp()
+		};
+
+		int32 changedSettings = 0;
+
+		for (int32 setting = 0; setting < NumSettings; setting++)
+		{
+			changedSettings |= bChanged[setting] ? 1 << setting : 0;
+		}
+
+		return changedSettings;
+	}
+
+	/** Reads GetNoise2D/3D(...) through the tile cache, defined with it in FastNoiseWrapper.cpp */
+	float GetCachedNoise2D(const float x, const float y);
+	float GetCachedNoise3D(const float x, const float y, const float z);
+
+	/** Returns a copy of the current settings, keeping the cellular noise lookup it points to alive as long as the copy */
+	TSharedRef<const FastNoise, ESPMode::ThreadSafe> CopySettings() const { return FFastNoiseEvaluator::MakeSnapshot(fastNoise, cellularNoiseLookup); }
+
+	/** Saved settings, kept equal to fastNoise by PublishSnapshot() */
+	UPROPERTY(EditAnywhere, Category = "Fast Noise", meta = (ShowOnlyInnerProperties, AllowPrivateAccess = "true"))
+	FFastNoiseSettings noiseSettings;
+
+	UPROPERTY()
 	bool bInitialized = false;
+
+	/** Settings edited by the setters, only accessed from the thread owning the wrapper */
+	FastNoise fastNoise;
+
+	/** Evaluator of the published snapshot, sampled by the grids and batches */
+	FFastNoiseEvaluator evaluator;
+
+	/** GetNoise(...) specialized for the current noise type, fractal type and interpolation */
+	FastNoise::NoiseFunc2D noiseFunc2D = nullptr;
+	FastNoise::NoiseFunc3D noiseFunc3D = nullptr;
+	uint64 settingsHash = 0;
+
+	UPROPERTY(Transient)
+	UFastNoiseTileCache* tileCache = nullptr;
+	bool bTileCacheApproximate = false;
+
+	/** Snapshot of the wrapper set with SetCellularNoiseLookup(...), fastNoise points to it */
+	TSharedPtr<const FastNoise, ESPMode::ThreadSafe> cellularNoiseLookup;
+
+	TSharedPtr<const FastNoise, ESPMode::ThreadSafe> snapshot;
+	uint64 snapshotHash = 0;
+	FCriticalSection snapshotLock;
+
+	static constexpr int32 NumSettings = int32(EFastNoise_Setting::GradientPerturbAmp) + 1;
+
+	/** Change tracking, settingVersions holding the settingsVersion of the last change of each setting */
+	int32 settingsVersion = 0;
+	int32 settingVersions[NumSettings] = {};
+	bool bSnapshotInitialized = false;
 };